@@ -0,0 +1,144 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * Small shared toolkit for the benchmarks in main/bench: repeated timing with std::chrono::steady_clock
+ * and machine readable (CSV or JSON) output, so that results can be compared between releases. The calls to
+ * the objective are counted with testfunction::counted (see utils/test-functions.h).
+ **/
+namespace bench {
+
+struct statistics {
+	double mean = 0, min = 0, max = 0, stddev = 0;
+	statistics() { }
+	statistics(const std::vector<double>& samples) {
+		if (samples.empty()) return;
+		min = *std::min_element(samples.begin(), samples.end());
+		max = *std::max_element(samples.begin(), samples.end());
+		for (double s : samples) mean += s;
+		mean /= double(samples.size());
+		for (double s : samples) stddev += (s - mean)*(s - mean);
+		stddev = std::sqrt(stddev/double(samples.size()));
+	}
+};
+
+/**
+ * Calls f(repetition) for each repetition and returns the statistics of the time (in seconds) of each call
+ **/
+template<typename F>
+statistics timed(unsigned int repetitions, const F& f) {
+	std::vector<double> seconds;
+	for (unsigned int r = 0; r < repetitions; ++r) {
+		auto start = std::chrono::steady_clock::now();
+		f(r);
+		auto stop = std::chrono::steady_clock::now();
+		seconds.push_back(std::chrono::duration<double>(stop - start).count());
+	}
+	return statistics(seconds);
+}
+
+/**
+ * Table of results, written as CSV or JSON (an array of objects) once all the rows have been added. Values
+ * that are numbers are written as such in JSON, and the rest as strings (escaping quotes and backslashes).
+ **/
+class report {
+	std::vector<std::vector<std::pair<std::string, std::string>>> rows;
+
+	static std::string quoted(const std::string& s) {
+		std::string q = "\"";
+		for (char c : s) {
+			if ((c == '"') || (c == '\\')) q += '\\';
+			q += c;
+		}
+		return q + "\"";
+	}
+
+	static bool is_number(const std::string& s) {
+		if (s.empty()) return false;
+		char* end;
+		std::strtod(s.c_str(), &end);
+		return (*end == '\0') && (s != "nan") && (s != "inf") && (s != "-inf");
+	}
+
+public:
+	class row {
+		std::vector<std::pair<std::string, std::string>>& fields;
+	public:
+		row(std::vector<std::pair<std::string, std::string>>& fields) : fields(fields) { }
+		template<typename T>
+		row& operator()(const std::string& name, const T& value) {
+			std::ostringstream s; s<<std::setprecision(6)<<value;
+			fields.emplace_back(name, s.str());
+			return *this;
+		}
+		row& operator()(const std::string& name, const statistics& stats) {
+			return (*this)(name + "_mean", stats.mean)(name + "_min", stats.min)(name + "_max", stats.max)(name + "_stddev", stats.stddev);
+		}
+	};
+
+	row add() { rows.emplace_back(); return row(rows.back()); }
+
+	void csv(std::ostream& os) const {
+		if (rows.empty()) return;
+		for (std::size_t i = 0; i < rows.front().size(); ++i) os<<(i?",":"")<<rows.front()[i].first;
+		os<<std::endl;
+		for (const auto& r : rows) {
+			for (std::size_t i = 0; i < r.size(); ++i) os<<(i?",":"")<<r[i].second;
+			os<<std::endl;
+		}
+	}
+
+	void json(std::ostream& os) const {
+		os<<"["<<std::endl;
+		for (std::size_t j = 0; j < rows.size(); ++j) {
+			os<<"  {";
+			for (std::size_t i = 0; i < rows[j].size(); ++i) {
+				os<<(i?", ":"")<<quoted(rows[j][i].first)<<": ";
+				if (is_number(rows[j][i].second)) os<<rows[j][i].second;
+				else                              os<<quoted(rows[j][i].second);
+			}
+			os<<"}"<<((j + 1 < rows.size())?",":"")<<std::endl;
+		}
+		os<<"]"<<std::endl;
+	}
+
+	void write(const std::string& format, const std::string& output) const {
+		std::ofstream file;
+		if (!output.empty()) file.open(output);
+		std::ostream& os = output.empty()?std::cout:file;
+		if (format == "json") json(os);
+		else                  csv(os);
+	}
+};
+
+/**
+ * Options shared by all benchmarks: -repetitions, -seed, -format (csv or json) and -output (a file, standard output by default)
+ **/
+struct options {
+	unsigned int  repetitions = 5;
+	unsigned long seed        = 0;
+	std::string   format      = "csv";
+	std::string   output;
+
+	options(int argc, char** argv) {
+		for (int i = 0; i<argc-1; ++i) {
+			if (strcmp("-repetitions", argv[i])==0) repetitions = atoi(argv[++i]);
+			else if (strcmp("-seed", argv[i])==0)   seed = atol(argv[++i]);
+			else if (strcmp("-format", argv[i])==0) format = argv[++i];
+			else if (strcmp("-output", argv[i])==0) output = argv[++i];
+		}
+	}
+};
+
+} //namespace bench
@@ -0,0 +1,86 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include "../bench.h"
+#include <vector>
+#include <random>
+
+namespace std {
+	template<> struct hash<std::vector<float>> {
+		size_t operator()(const std::vector<float>& v) const {
+			size_t seed = 0;
+			for (float f : v) seed ^= std::hash<float>()(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+}
+
+std::vector<std::vector<float>> initial_population(unsigned int size, unsigned int dimension, unsigned long seed) {
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> sample(-2.0f, 2.0f);
+	std::vector<std::vector<float>> population(size, std::vector<float>(dimension));
+	for (auto& x : population) for (float& xi : x) xi = sample(random);
+	return population;
+}
+
+//Extended Rosenbrock function (consecutive pairs), minimum 0 at (1,...,1), on genomes of N elements
+template<std::size_t N, typename Run>
+void benchmark(bench::report& report, const bench::options& options, const char* engine, unsigned int population, const Run& run) {
+	testfunction::rosenbrock_n<N> rosenbrock;
+	testfunction::counted<testfunction::rosenbrock_n<N>> f(rosenbrock);
+	std::vector<double> values;
+	bench::statistics time = bench::timed(options.repetitions, [&] (unsigned int r) {
+		values.push_back(rosenbrock(run(f, options.seed + r)));
+	});
+	report.add()("engine", engine)("dimension", N)("population", population)("repetitions", options.repetitions)
+		("seconds", time)("evaluations", double(f.evaluations())/double(options.repetitions))("value", bench::statistics(values));
+}
+
+template<std::size_t dimension>
+void benchmark(bench::report& report, const bench::options& options, unsigned int iters, const std::vector<unsigned int>& populations) {
+	auto mutation  = opt::mutation::vector_single(opt::mutation::real_normal(0.1f));
+	auto crossover = opt::crossover::vector_onepoint();
+	for (unsigned int population : populations) {
+		benchmark<dimension>(report, options, "GeneticBest", population, [&] (const auto& f, unsigned long seed) {
+			auto logger = opt::genetic_logger::null();
+			return opt::GeneticBest(iters, population, population, population, 2*population, seed).minimize(
+				initial_population(population, dimension, seed), f, mutation, crossover, 0.0f, logger); });
+		benchmark<dimension>(report, options, "GeneticStochastic", population, [&] (const auto& f, unsigned long seed) {
+			auto logger = opt::genetic_logger::null();
+			return opt::GeneticStochastic(iters, population, population, 2*population, seed).minimize(
+				initial_population(population, dimension, seed), f, mutation, crossover, 0.0f, logger); });
+		benchmark<dimension>(report, options, "GeneticStochasticBest", population, [&] (const auto& f, unsigned long seed) {
+			auto logger = opt::genetic_logger::null();
+			return opt::GeneticStochasticBest(iters, population, population, 2*population, seed, 1, opt::SelectionPolicy::universal).minimize(
+				initial_population(population, dimension, seed), f, mutation, crossover, 0.0f, logger); });
+	}
+	benchmark<dimension>(report, options, "PatternSearch", 1, [&] (const auto& f, unsigned long seed) {
+		auto logger = opt::pattern_search_logger::null();
+		return opt::PatternSearch(iters, 1.0f, 1.e-5f).minimize(initial_population(1, dimension, seed).front(), f, logger); });
+}
+
+//The dimension of the test function is a template parameter, so only these ones are available
+template<std::size_t... dimensions>
+bool benchmark(unsigned int dimension, bench::report& report, const bench::options& options, unsigned int iters, const std::vector<unsigned int>& populations) {
+	return (((dimension == dimensions) && (benchmark<dimensions>(report, options, iters, populations), true)) || ...);
+}
+
+int main(int argc, char** argv) {
+	bench::options options(argc, argv);
+	unsigned int iters = 200;
+	std::vector<unsigned int> dimensions{2, 10, 50};
+	std::vector<unsigned int> populations{20, 100};
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0) iters = atoi(argv[++i]);
+		else if (strcmp("-dimensions", argv[i])==0) { dimensions.clear(); std::istringstream s(argv[++i]); for (unsigned int d; s>>d; s.ignore()) dimensions.push_back(d); }
+		else if (strcmp("-populations", argv[i])==0) { populations.clear(); std::istringstream s(argv[++i]); for (unsigned int p; s>>p; s.ignore()) populations.push_back(p); }
+	}
+
+	bench::report report;
+	for (unsigned int dimension : dimensions) {
+		if (!benchmark<2, 4, 10, 20, 50, 100>(dimension, report, options, iters, populations)) {
+			std::cerr<<"Unsupported dimension "<<dimension<<" (use 2, 4, 10, 20, 50 or 100)"<<std::endl;
+			return 1;
+		}
+	}
+	report.write(options.format, options.output);
+}
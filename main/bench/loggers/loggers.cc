@@ -0,0 +1,78 @@
+#include "../../../opt.h"
+#include "../bench.h"
+#include <vector>
+#include <array>
+#include <random>
+
+//Extended Rosenbrock function (consecutive pairs), cheap so that the cost of logging is noticeable
+float rosenbrock(const std::array<float,10>& x) {
+	float s = 0.0f;
+	for (std::size_t i = 0; i + 1 < x.size(); i += 2) 
+		s += (1.0f - x[i])*(1.0f - x[i]) + 100.0f*(x[i+1] - x[i]*x[i])*(x[i+1] - x[i]*x[i]);
+	return s;
+}
+
+namespace std {
+	template<> struct hash<std::array<float,10>> {
+		size_t operator()(const std::array<float,10>& x) const {
+			size_t seed = 0;
+			for (float f : x) seed ^= std::hash<float>()(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+}
+
+//Logger that only counts the generations, the cheapest logger that does something
+class counting {
+	unsigned long generations = 0;
+public:
+	template<typename Iterator>
+	void log(unsigned long iteration, const Iterator& begin, const Iterator& end) { ++generations; }
+	unsigned long count() const { return generations; }
+};
+
+/**
+ * Time of each genetic engine with the null logger (which should cost nothing, as its calls are inlined away),
+ * with a logger that only counts the generations and with a stream logger that formats the whole population
+ * into a discarded stream (the cost that quiet runs used to pay).
+ **/
+template<typename Run>
+void benchmark(bench::report& report, const bench::options& options, const char* engine, const Run& run) {
+	std::ofstream discarded("/dev/null");
+	std::vector<std::array<float,10>> population(50);
+	auto measure = [&] (const char* logger_name, auto& logger) {
+		bench::statistics time = bench::timed(options.repetitions, [&] (unsigned int r) {
+			std::mt19937 random(options.seed + r);
+			std::uniform_real_distribution<float> sample(-2.0f, 2.0f);
+			for (auto& x : population) for (float& xi : x) xi = sample(random);
+			run(population, logger, options.seed + r);
+		});
+		report.add()("engine", engine)("logger", logger_name)("repetitions", options.repetitions)("seconds", time);
+	};
+	auto null = opt::genetic_logger::null();
+	measure("null", null);
+	counting count;
+	measure("counting", count);
+	auto stream = opt::genetic_logger::stream(discarded);
+	measure("stream", stream);
+}
+
+int main(int argc, char** argv) {
+	bench::options options(argc, argv);
+	unsigned int iters = 200;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0) iters = atoi(argv[++i]);
+	}
+
+	auto mutation  = opt::mutation::vector_single(opt::mutation::real_normal(0.1f));
+	auto crossover = opt::crossover::vector_onepoint();
+	auto f = [] (const std::array<float,10>& x) { return rosenbrock(x); };
+	bench::report report;
+	benchmark(report, options, "GeneticBest", [&] (const auto& population, auto& logger, unsigned long seed) {
+		return opt::GeneticBest(iters, 50, 50, 50, 100, seed).minimize(population, f, mutation, crossover, 0.0f, logger); });
+	benchmark(report, options, "GeneticStochastic", [&] (const auto& population, auto& logger, unsigned long seed) {
+		return opt::GeneticStochastic(iters, 50, 50, 100, seed).minimize(population, f, mutation, crossover, 0.0f, logger); });
+	benchmark(report, options, "GeneticStochasticBest", [&] (const auto& population, auto& logger, unsigned long seed) {
+		return opt::GeneticStochasticBest(iters, 50, 50, 100, seed).minimize(population, f, mutation, crossover, 0.0f, logger); });
+	report.write(options.format, options.output);
+}
@@ -0,0 +1,112 @@
+#include "../../../opt.h"
+#include "../bench.h"
+#include <vector>
+#include <array>
+#include <tuple>
+#include <random>
+
+//Nanoseconds per call of a mutation operator, over a fixed pool of elements
+template<typename X, typename FMutation>
+void mutation(bench::report& report, const bench::options& options, unsigned int calls, const char* genome, const char* name, std::size_t size, 
+	      const std::vector<X>& elements, const FMutation& mutate) {
+	std::vector<X> results(elements);
+	bench::statistics time = bench::timed(options.repetitions, [&] (unsigned int r) {
+		std::mt19937 random(options.seed + r);
+		for (unsigned int i = 0; i < calls; ++i) {
+			std::size_t j = i % elements.size();
+			opt::mutate_into(mutate, elements[j], results[j], random);
+		}
+	});
+	report.add()("operator", name)("kind", "mutation")("genome", genome)("size", size)("repetitions", options.repetitions)("calls", calls)
+		("in_place", opt::InPlaceMutationFunction<FMutation, X>?1:0)("nanoseconds_per_call", 1.e9*time.mean/double(calls))("seconds", time);
+}
+
+//Nanoseconds per call of a crossover operator, over a fixed pool of elements
+template<typename X, typename FCrossover>
+void crossover(bench::report& report, const bench::options& options, unsigned int calls, const char* genome, const char* name, std::size_t size, 
+	      const std::vector<X>& elements, const FCrossover& cross) {
+	std::vector<X> results(elements);
+	bench::statistics time = bench::timed(options.repetitions, [&] (unsigned int r) {
+		std::mt19937 random(options.seed + r);
+		for (unsigned int i = 0; i < calls; ++i) {
+			std::size_t j = i % elements.size();
+			opt::cross_into(cross, elements[j], elements[(j + 1) % elements.size()], results[j], random);
+		}
+	});
+	report.add()("operator", name)("kind", "crossover")("genome", genome)("size", size)("repetitions", options.repetitions)("calls", calls)
+		("in_place", opt::InPlaceCrossoverFunction<FCrossover, X>?1:0)("nanoseconds_per_call", 1.e9*time.mean/double(calls))("seconds", time);
+}
+
+template<typename X, typename F>
+std::vector<X> elements(const F& sample) {
+	std::vector<X> e(64);
+	for (X& x : e) x = sample();
+	return e;
+}
+
+//Vector genomes, both as std::array<float,N> and std::vector<float>
+template<std::size_t N>
+void vectors(bench::report& report, const bench::options& options, unsigned int calls, std::mt19937& random) {
+	std::normal_distribution<float> normal;
+	auto arrays  = elements<std::array<float,N>>([&] () { std::array<float,N> a; for (float& f : a) f = normal(random); return a; });
+	std::vector<std::vector<float>> vectors;
+	for (const auto& a : arrays) vectors.emplace_back(a.begin(), a.end());
+	auto single = opt::mutation::vector_single(opt::mutation::real_normal(0.1f));
+	auto all    = opt::mutation::vector_all(opt::mutation::real_normal(0.1f));
+	mutation(report, options, calls, "array<float>", "vector_single(real_normal)", N, arrays, single);
+	mutation(report, options, calls, "vector<float>", "vector_single(real_normal)", N, vectors, single);
+	mutation(report, options, calls, "array<float>", "vector_all(real_normal)", N, arrays, all);
+	mutation(report, options, calls, "vector<float>", "vector_all(real_normal)", N, vectors, all);
+	crossover(report, options, calls, "array<float>", "vector_onepoint", N, arrays, opt::crossover::vector_onepoint());
+	crossover(report, options, calls, "vector<float>", "vector_onepoint", N, vectors, opt::crossover::vector_onepoint());
+	crossover(report, options, calls, "array<float>", "vector_uniform", N, arrays, opt::crossover::vector_uniform());
+	crossover(report, options, calls, "vector<float>", "vector_uniform", N, vectors, opt::crossover::vector_uniform());
+}
+
+int main(int argc, char** argv) {
+	bench::options options(argc, argv);
+	unsigned int calls = 100000;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-calls", argv[i])==0) calls = atoi(argv[++i]);
+	}
+
+	std::mt19937 random(options.seed);
+	std::uniform_int_distribution<int> ints(-1000, 1000);
+	std::normal_distribution<double> reals;
+	bench::report report;
+
+	auto i32 = elements<int>([&] () { return ints(random); });
+	mutation(report, options, calls, "int", "bit32_swap", 1, i32, opt::mutation::bit32_swap());
+	mutation(report, options, calls, "int", "int_uniform", 1, i32, opt::mutation::int_uniform<int>(-1000, 1000));
+	crossover(report, options, calls, "int", "bit32_onepoint", 1, i32, opt::crossover::bit32_onepoint());
+
+	auto i64 = elements<long>([&] () { return long(ints(random)); });
+	mutation(report, options, calls, "long", "bit64_swap", 1, i64, opt::mutation::bit64_swap());
+	crossover(report, options, calls, "long", "bit64_onepoint", 1, i64, opt::crossover::bit64_onepoint());
+
+	auto f32 = elements<float>([&] () { return float(reals(random)); });
+	mutation(report, options, calls, "float", "bit32_swap", 1, f32, opt::mutation::bit32_swap());
+	mutation(report, options, calls, "float", "real_uniform", 1, f32, opt::mutation::real_uniform<float>(-1.0f, 1.0f));
+	mutation(report, options, calls, "float", "real_normal", 1, f32, opt::mutation::real_normal<float>(0.1f));
+	crossover(report, options, calls, "float", "bit32_onepoint", 1, f32, opt::crossover::bit32_onepoint());
+
+	auto f64 = elements<double>([&] () { return reals(random); });
+	mutation(report, options, calls, "double", "bit64_swap", 1, f64, opt::mutation::bit64_swap());
+	mutation(report, options, calls, "double", "real_normal", 1, f64, opt::mutation::real_normal<double>(0.1));
+	crossover(report, options, calls, "double", "bit64_onepoint", 1, f64, opt::crossover::bit64_onepoint());
+
+	vectors<8>(report, options, calls, random);
+	vectors<64>(report, options, calls, random);
+	vectors<512>(report, options, calls, random);
+
+	auto tuples = elements<std::tuple<float,double,int>>([&] () { return std::make_tuple(float(reals(random)), reals(random), ints(random)); });
+	auto each = std::make_tuple(opt::mutation::real_normal<float>(0.1f), opt::mutation::real_normal<double>(0.1), opt::mutation::bit32_swap());
+	mutation(report, options, calls, "tuple<float,double,int>", "tuple_single", 3, tuples, std::make_from_tuple<opt::mutation::tuple_single<
+		opt::mutation::real_normal<float>, opt::mutation::real_normal<double>, opt::mutation::bit32_swap>>(each));
+	mutation(report, options, calls, "tuple<float,double,int>", "tuple_all", 3, tuples, std::make_from_tuple<opt::mutation::tuple_all<
+		opt::mutation::real_normal<float>, opt::mutation::real_normal<double>, opt::mutation::bit32_swap>>(each));
+	crossover(report, options, calls, "tuple<float,double,int>", "tuple_onepoint", 3, tuples, opt::crossover::tuple_onepoint());
+	crossover(report, options, calls, "tuple<float,double,int>", "tuple_uniform", 3, tuples, opt::crossover::tuple_uniform());
+
+	report.write(options.format, options.output);
+}
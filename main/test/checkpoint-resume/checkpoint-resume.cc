@@ -0,0 +1,149 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+//GeneticBest keeps a hash table of the population
+namespace std {
+	template<> struct hash<std::array<float,4>> {
+		size_t operator()(const std::array<float,4>& x) const {
+			size_t seed = 0;
+			for (float f : x) seed ^= std::hash<float>()(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+}
+
+//Thrown by the function to minimize to interrupt a method, as if the program had been killed
+struct killed { };
+
+//Function to minimize that is killed as soon as the checkpoint file exists (so right after the first save)
+template<typename F>
+class KilledAfterCheckpoint {
+	F f;
+	std::string path;
+public:
+	KilledAfterCheckpoint(const F& f, const std::string& path) : f(f), path(path) { }
+	float operator()(const std::array<float,4>& x) const {
+		if (std::ifstream(path)) throw killed();
+		return f(x);
+	}
+};
+
+//Runs each method for all its iterations at once and killed after its first checkpoint (halfway) and then resumed,
+//and checks that both get the same result (unless the method is not exactly reproducible after resuming) and that
+//the checkpoint is removed when the method finishes
+template<typename Run>
+bool test_method(const char* name, const std::string& path, unsigned long every, bool exact, const Run& run) {
+	testfunction::rosenbrock_n<4> f;
+	std::remove(path.c_str());
+	std::array<float,4> uninterrupted = run(f, opt::checkpoint());
+	bool was_killed = false;
+	try { run(KilledAfterCheckpoint<testfunction::rosenbrock_n<4>>(f, path), opt::checkpoint(path, every)); }
+	catch (const killed&) { was_killed = true; }
+	std::array<float,4> resumed = run(f, opt::checkpoint(path, every));
+	bool removed = !std::ifstream(path);
+	std::remove(path.c_str());
+	bool same = resumed == uninterrupted;
+	std::cout<<std::setw(16)<<name<<"\t| Resumed = "<<std::setw(10)<<f(resumed)<<"\t| Uninterrupted = "<<std::setw(10)<<f(uninterrupted)
+		<<"\t| "<<(was_killed?"":"NOT KILLED | ")<<(same?"Same result":(exact?"DIFFERENT result":"Not reproducible"))
+		<<(removed?"":" | CHECKPOINT LEFT")<<std::endl;
+	return was_killed && removed && (same || !exact);
+}
+
+//The stopping criteria of a resumed run continue from the saved state: the stagnation count (a run killed after
+//two stagnant iterations stops after a third one), the evaluations and the time spent
+bool test_monitor() {
+	opt::stopping criteria = opt::stopping().stagnation(3).evaluations(100).time(1000.0);
+	opt::stopping::monitor killed = criteria.start();
+	killed.evaluated(90);
+	for (int i = 0; i < 3; ++i) killed.iteration(1.0);
+	opt::stopping::monitor::state saved = killed.saved();
+	opt::stopping::monitor resumed = criteria.start();
+	resumed.restore(saved);
+	bool stagnation = !resumed.stop() && (resumed.iteration(1.0), resumed.stop());
+	resumed = criteria.start(); resumed.restore(saved);
+	resumed.iteration(0.5); resumed.evaluated(10);
+	bool evaluations = resumed.stop() && (resumed.evaluations() == 100);
+	bool time = (resumed.elapsed() >= saved.elapsed);
+	bool ok = stagnation && evaluations && time;
+	std::cout<<std::setw(16)<<"Stopping"<<"\t| Stagnation, evaluations and time "<<(ok?"restored":"NOT RESTORED")<<std::endl;
+	return ok;
+}
+
+//A checkpoint of a run must not be resumed by a run with other parameters
+template<typename Run>
+bool test_other_run(const char* name, const std::string& path, unsigned long every, const Run& run, const Run& other) {
+	testfunction::rosenbrock_n<4> f;
+	std::remove(path.c_str());
+	try { run(KilledAfterCheckpoint<testfunction::rosenbrock_n<4>>(f, path), opt::checkpoint(path, every)); } catch (const killed&) { }
+	bool rejected = false;
+	try { other(f, opt::checkpoint(path, every)); } catch (const std::runtime_error&) { rejected = true; }
+	std::remove(path.c_str());
+	std::cout<<std::setw(16)<<name<<"\t| Checkpoint of another run "<<(rejected?"rejected":"NOT REJECTED")<<std::endl;
+	return rejected;
+}
+
+//The starts of a multi-start pattern search run without the checkpoint of its local search, which they would share
+bool test_multi_start(const std::string& path, unsigned long every, unsigned long seed) {
+	testfunction::rosenbrock_n<4> f;
+	auto logger = opt::pattern_search_logger::null();
+	std::remove(path.c_str());
+	opt::PatternSearch local(1000, 1.0f, 1.e-6f, 1, false, opt::stopping(), opt::checkpoint(path, every));
+	bool ok = true;
+	try { opt::multi_start(local, 16, 2.0f, 8, -1.0f, seed).minimize(std::array<float,4>{}, f, logger); } catch (const std::exception&) { ok = false; }
+	ok = ok && !std::ifstream(path);
+	std::remove(path.c_str());
+	std::cout<<std::setw(16)<<"MultiStart"<<"\t| Checkpoint of the local search "<<(ok?"ignored":"NOT IGNORED")<<std::endl;
+	return ok;
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters = 1000;
+	unsigned long seed = (std::random_device())();
+	std::string path = "checkpoint-resume.checkpoint";
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)  iters = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)   seed = atol(argv[++i]);
+		else if (strcmp("-output", argv[i])==0) path = argv[++i];
+	}
+
+	std::mt19937 random(seed);
+	auto initial_population = opt::initialization::population(40, opt::initialization::array<4>(opt::initialization::real_uniform(random, -2.0f, 2.0f)));
+	auto mutation  = opt::mutation::vector_single(opt::mutation::real_normal(0.05f));
+	auto crossover = opt::crossover::vector_onepoint();
+	auto logger = opt::genetic_logger::null();
+
+	bool ok = true;
+	unsigned long every = iters/2; //The first checkpoint is halfway
+	auto stochastic_best = [&] (unsigned long seed) {
+		return [&, seed] (const auto& f, const opt::checkpoint& checkpoint) {
+			return opt::GeneticStochasticBest(iters, 20, 20, 40, seed, 1, opt::SelectionPolicy::discrete, opt::stopping(), checkpoint).minimize(
+				initial_population, f, mutation, crossover, 0.0f, logger); };
+	};
+	ok = test_method("StochasticBest", path, every, true, stochastic_best(seed)) && ok;
+	ok = test_method("Stochastic", path, every, true, [&] (const auto& f, const opt::checkpoint& checkpoint) {
+		return opt::GeneticStochastic(iters, 20, 20, 40, seed, opt::stopping(), checkpoint).minimize(
+			initial_population, f, mutation, crossover, 0.0f, logger); }) && ok;
+	ok = test_method("Best", path, every, true, [&] (const auto& f, const opt::checkpoint& checkpoint) {
+		return opt::GeneticBest(iters, 10, 20, 10, 20, seed, opt::stopping(), checkpoint).minimize(
+			initial_population, f, mutation, crossover, 0.0f, logger); }) && ok;
+	ok = test_method("PatternSearch", path, every, true, [&] (const auto& f, const opt::checkpoint& checkpoint) {
+		auto logger = opt::pattern_search_logger::null();
+		return opt::PatternSearch(iters, 1.0f, 1.e-7f, 1, false, opt::stopping(), checkpoint).minimize(initial_population.front(), f, logger); }) && ok;
+	ok = test_monitor() && ok;
+	ok = test_multi_start(path, 1, seed) && ok;
+	ok = test_other_run("StochasticBest", path, every, stochastic_best(seed), stochastic_best(seed + 1)) && ok;
+	//The opportunistic poll depends on the number of threads
+	auto opportunistic = [&] (unsigned int threads) {
+		return [&, threads] (const auto& f, const opt::checkpoint& checkpoint) {
+			auto logger = opt::pattern_search_logger::null();
+			return opt::PatternSearch(iters, 1.0f, 1.e-7f, threads, true, opt::stopping(), checkpoint).minimize(initial_population.front(), f, logger); };
+	};
+	ok = test_other_run("Opportunistic", path, every, opportunistic(2), opportunistic(3)) && ok;
+	return ok?0:1;
+}
@@ -0,0 +1,71 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+template<typename F, typename Run>
+void test_method(const char* name, const F& function, const Run& run) {
+	testfunction::counted<F> f(function);
+	auto start = std::chrono::steady_clock::now();
+	auto sol = run(f);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Error = "<<std::setw(10)<<function.error(sol)<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<std::endl;
+}
+
+template<std::size_t N>
+void test(unsigned long iters, unsigned long seed, unsigned int threads) {
+	std::cout<<"Rosenbrock, dimension "<<N<<std::endl;
+	testfunction::rosenbrock_n<N> function;
+	std::array<float,N> ini; ini.fill(-1.0f);
+	test_method("StochasticBest", function, [&] (const auto& f) {
+		std::mt19937 random(seed);
+		auto initial_population = opt::initialization::population(100,
+				opt::initialization::array<N>(opt::initialization::real_uniform(random, -2.0f, 2.0f)));
+		auto logger = opt::genetic_logger::null();
+		return opt::GeneticStochasticBest(iters, 100, 100, 100, seed).minimize(initial_population, f,
+				opt::mutation::vector_single(opt::mutation::real_normal(0.01f)), opt::crossover::vector_onepoint(), 1.e-6f, logger); });
+	test_method("PatternSearch", function, [&] (const auto& f) {
+		auto logger = opt::pattern_search_logger::null();
+		return opt::PatternSearch(100*iters, 1.0f, 1.e-6f).minimize(ini, f, logger); });
+	test_method("CMA-ES", function, [&] (const auto& f) {
+		auto logger = opt::pattern_search_logger::null();
+		return opt::CMAES(iters, 0.5f, 0, 1.e-6f, threads, seed).minimize(ini, f, logger); });
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters = 10000;
+	unsigned long seed = (std::random_device())();
+	unsigned int threads = 1;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)   iters = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0) threads = atoi(argv[++i]);
+	}
+	test<2>(iters, seed, threads);
+	test<10>(iters, seed, threads);
+
+	//Also for vectors of doubles, and through opt::minimize (same interface as pattern search)
+	auto ellipsoid = [] (const std::vector<double>& x) {
+		double s = 0.0;
+		for (std::size_t i = 0; i < x.size(); ++i) s += std::pow(1.e3, double(i)/double(x.size() - 1))*(x[i] - 1.0)*(x[i] - 1.0);
+		return s;
+	};
+	std::vector<double> x = opt::minimize(ellipsoid, opt::cmaes(iters, 1.0f, 0, 1.e-8f, threads, seed), std::vector<double>(8, 0.0));
+	std::cout<<"Ellipsoid 8D: [";
+	for (double xi : x) std::cout<<" "<<xi;
+	std::cout<<" ] should be close to [ 1 1 1 1 1 1 1 1 ]"<<std::endl;
+
+	//A batch function gets each generation in a single call
+	auto ellipsoid_batch = [&ellipsoid] (opt::span<const std::vector<double>> xs, opt::span<double> ys) {
+		for (std::size_t k = 0; k < xs.size(); ++k) ys[k] = ellipsoid(xs[k]);
+	};
+	auto logger = opt::pattern_search_logger::null();
+	x = opt::cmaes(iters, 1.0f, 0, 1.e-8f, threads, seed).minimize<double>(std::vector<double>(8, 0.0), ellipsoid_batch, logger);
+	std::cout<<"Ellipsoid 8D (batch): [";
+	for (double xi : x) std::cout<<" "<<xi;
+	std::cout<<" ] should be close to [ 1 1 1 1 1 1 1 1 ]"<<std::endl;
+}
@@ -1,107 +1,116 @@
 #include "../../../opt.h"
-#include "../../../utils/null-ostream.h"
 #include "../../../utils/test-functions.h"
 #include <iostream>
+#include <iomanip>
 #include <cstring>
 #include <chrono>
-
-std::ostream& operator<<(std::ostream& os, const std::array<float,2>& a) {
-	os<<" <"<<a[0]<<" , "<<a[1]<<"> ";
-	return os;
-}
+#include <string>
 
 namespace std {
     template <size_t N> struct hash<std::array<float,N>>
     {
         size_t operator()(const std::array<float,N>& a) const
         {
-			return std::hash<float>()(a[0]+a[1]);
+			size_t seed = 0;
+			for (float f : a) seed ^= std::hash<float>()(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
         }
     };
 }
 
-template<typename Method>
-requires !opt::GeneticMethod<Method>
-void test_method(const char* name, const testfunction::rosenbrock& f, const Method& method) {
-	null_ostream os;
-	auto start = std::chrono::system_clock::now();
-	std::array<float,2> sol = method.minimize(
-			std::array<float, 2>{0.0f,0.0f},
-			f, 
-			os); 
-	auto stop = std::chrono::system_clock::now();
+struct parameters {
+	unsigned int iters = 1000;
+	unsigned long seed = (std::random_device())();
+	unsigned int population = 50;
+	unsigned int mutations  = 50;
+	unsigned int crossovers = 50;
+	float        step       = 1.0f;
+	float        epsilon    = 0.0001f;
+};
+
+template<typename Function, typename Run>
+void test_method(const char* name, const Function& f, const Run& run) {
+	auto start = std::chrono::steady_clock::now();
+	auto sol = run();
+	auto stop = std::chrono::steady_clock::now();
 	std::chrono::duration<float> duration = stop - start;
-	std::cout<<std::setw(20)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = "
-						<<sol<<"\t| Value at result = "<<f(sol)<<"\t| Error = "<< f.error(sol)<<std::endl;
+	std::cout<<std::setw(20)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "
+						<<std::setw(10)<<f(sol)<<"\t| Error = "<<f.error(sol)<<std::endl;
 }
 
-void test_method(const char* name, const testfunction::rosenbrock& f, const opt::GeneticStochasticBest& method) {
-	auto logger = opt::genetic_logger::null();
-	auto start = std::chrono::system_clock::now();
-	std::mt19937 random;
-	std::array<float,2> sol = method.minimize(
-			opt::initialization::population(100, 
-					opt::initialization::array<2>(opt::initialization::real_uniform(random, -100.0f, 100.0f))),
-			f, 
-			opt::mutation::vector_single(opt::mutation::real_normal(1.0f)),
-			opt::crossover::vector_onepoint(),
-			1.e-4f,
-			logger); 
-	auto stop = std::chrono::system_clock::now();
-	std::chrono::duration<float> duration = stop - start;
-	std::cout<<std::setw(20)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = "
-						<<sol<<"\t| Value at result = "<<f(sol)<<"\t| Error = "<< f.error(sol)<<std::endl;
+template<typename Function>
+void compare(const Function& f, const parameters& p) {
+	constexpr std::size_t N = Function::dimension;
+	std::mt19937 random(p.seed);
+	auto initial_population = opt::initialization::population(100,
+					opt::initialization::array<N>(opt::initialization::real_uniform(random, f.lower(), f.upper())));
+	auto mutation  = opt::mutation::vector_single(opt::mutation::real_normal(0.01f*(f.upper() - f.lower())));
+	auto crossover = opt::crossover::vector_onepoint();
+	float threshold = f.minimum() + 1.e-4f;
 
+	test_method("Best", f, [&] () {
+		auto logger = opt::genetic_logger::null();
+		return opt::GeneticBest(p.iters, p.population, p.mutations, p.population, p.crossovers, p.seed).minimize(
+			initial_population, f, mutation, crossover, threshold, logger); });
+	test_method("Stochastic", f, [&] () {
+		auto logger = opt::genetic_logger::null();
+		return opt::GeneticStochastic(p.iters, p.population, p.mutations, p.crossovers, p.seed).minimize(
+			initial_population, f, mutation, crossover, threshold, logger); });
+	test_method("StochasticBest", f, [&] () {
+		auto logger = opt::genetic_logger::null();
+		return opt::GeneticStochasticBest(p.iters, p.population, p.mutations, p.crossovers, p.seed).minimize(
+			initial_population, f, mutation, crossover, threshold, logger); });
+	test_method("PatternSearch", f, [&] () {
+		auto logger = opt::pattern_search_logger::null();
+		return opt::PatternSearch(p.iters, p.step, p.epsilon).minimize(initial_population.front(), f, logger); });
 }
 
-template<typename Method>
-requires opt::GeneticMethod<Method>
-void test_method(const char* name, const testfunction::rosenbrock& f, const Method& method) {
-	null_ostream os;
-	auto start = std::chrono::system_clock::now();
-	std::mt19937 random;
-	std::array<float,2> sol = method.minimize(
-			opt::initialization::population(100, 
-					opt::initialization::array<2>(opt::initialization::real_uniform(random, -100.0f, 100.0f))),
-			f, 
-			opt::mutation::vector_single(opt::mutation::real_normal(1.0f)),
-			opt::crossover::vector_onepoint(),
-			1.e-4f,
-			os); 
-	auto stop = std::chrono::system_clock::now();
-	std::chrono::duration<float> duration = stop - start;
-	std::cout<<std::setw(20)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = "
-						<<sol<<"\t| Value at result = "<<f(sol)<<"\t| Error = "<< f.error(sol)<<std::endl;
+template<std::size_t N>
+bool compare(const std::string& function, float a, float b, const parameters& p) {
+	if (function == "rosenbrock")           compare(testfunction::rosenbrock_n<N>(a, b), p);
+	else if (function == "sphere")          compare(testfunction::sphere<N>(), p);
+	else if (function == "rastrigin")       compare(testfunction::rastrigin<N>(), p);
+	else if (function == "ackley")          compare(testfunction::ackley<N>(), p);
+	else if (function == "griewank")        compare(testfunction::griewank<N>(), p);
+	else if (function == "schwefel")        compare(testfunction::schwefel<N>(), p);
+	else if (function == "styblinski-tang") compare(testfunction::styblinski_tang<N>(), p);
+	else return false;
+	return true;
 }
 
 int main(int argc, char** argv) {
-	float a = 1.0; 
+	float a = 1.0;
 	float b = 100.0;
-	unsigned int iters = 1000;
-    unsigned long seed = (std::random_device())();
-	unsigned int population = 50;
-	unsigned int mutations  = 50;
-	unsigned int crossovers = 50;
-	float        step       = 1.0f;
-	float        epsilon    = 0.0001f;
+	std::string function = "rosenbrock";
+	unsigned int dimension = 2;
+	parameters p;
 
 	for (int i = 0; i<argc-1; ++i) {
 		if (strcmp("-a", argv[i])==0)      a = atof(argv[++i]);
 		else if (strcmp("-b", argv[i])==0) b = atof(argv[++i]);
-		else if (strcmp("-iterations", argv[i])==0) iters = atoi(argv[++i]);
-		else if (strcmp("-seed", argv[i])==0)       seed = atol(argv[++i]);
-		else if (strcmp("-population", argv[i])==0) population = atoi(argv[++i]);
-		else if (strcmp("-mutations", argv[i])==0)  mutations = atoi(argv[++i]);
-		else if (strcmp("-crossovers", argv[i])==0) crossovers = atoi(argv[++i]);
-		else if (strcmp("-step", argv[i])==0)       step = atof(argv[++i]);
-		else if (strcmp("-epsilon", argv[i])==0)    epsilon = atof(argv[++i]);
-		
+		else if (strcmp("-function", argv[i])==0)   function = argv[++i];
+		else if (strcmp("-dimension", argv[i])==0)  dimension = atoi(argv[++i]);
+		else if (strcmp("-iterations", argv[i])==0) p.iters = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)       p.seed = atol(argv[++i]);
+		else if (strcmp("-population", argv[i])==0) p.population = atoi(argv[++i]);
+		else if (strcmp("-mutations", argv[i])==0)  p.mutations = atoi(argv[++i]);
+		else if (strcmp("-crossovers", argv[i])==0) p.crossovers = atoi(argv[++i]);
+		else if (strcmp("-step", argv[i])==0)       p.step = atof(argv[++i]);
+		else if (strcmp("-epsilon", argv[i])==0)    p.epsilon = atof(argv[++i]);
+	}
+
+	bool found = false;
+	switch (dimension) {
+		case 2:   found = compare<2>(function, a, b, p); break;
+		case 10:  found = compare<10>(function, a, b, p); break;
+		case 30:  found = compare<30>(function, a, b, p); break;
+		case 100: found = compare<100>(function, a, b, p); break;
+		default:
+			std::cerr<<"Unsupported dimension "<<dimension<<" (use 2, 10, 30 or 100)"<<std::endl;
+			return 1;
+	}
+	if (!found) {
+		std::cerr<<"Unknown function "<<function<<" (use rosenbrock, sphere, rastrigin, ackley, griewank, schwefel or styblinski-tang)"<<std::endl;
+		return 1;
 	}
-	
-	testfunction::rosenbrock f(a,b);
-	
-	test_method("Best", f, opt::GeneticBest(iters, population, mutations, population, crossovers, seed));
-	test_method("Stochastic", f, opt::GeneticStochastic(iters, population, mutations, crossovers, seed));
-	test_method("StochasticBest", f, opt::GeneticStochasticBest(iters, population, mutations, crossovers, seed));
-	test_method("PatternSearch", f, opt::PatternSearch(iters, step, epsilon));
 }
@@ -0,0 +1,57 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+template<typename F, typename Run>
+void test_method(const char* name, const F& function, const Run& run) {
+	testfunction::counted<F> f(function);
+	auto start = std::chrono::steady_clock::now();
+	auto sol = run(f);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Error = "<<std::setw(10)<<function.error(sol)<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<std::endl;
+}
+
+template<typename Function>
+void test(const char* title, const Function& function, unsigned long iters, unsigned long seed, unsigned int threads) {
+	constexpr std::size_t N = Function::dimension;
+	std::cout<<title<<", dimension "<<N<<std::endl;
+	std::mt19937 random(seed);
+	auto initial_population = opt::initialization::population(10*N,
+			opt::initialization::array<N>(opt::initialization::real_uniform(random, function.lower(), function.upper())));
+	auto logger = opt::genetic_logger::null();
+	test_method("StochasticBest", function, [&] (const auto& f) {
+		return opt::GeneticStochasticBest(iters, 10*N, 10*N, 10*N, seed, threads).minimize(initial_population, f,
+				opt::mutation::vector_single(opt::mutation::real_normal(0.01f)), opt::crossover::vector_onepoint(), 1.e-6f, logger); });
+	test_method("DE rand/1/bin", function, [&] (const auto& f) {
+		return opt::DifferentialEvolution(iters, opt::DEStrategy::rand_1_bin, 0.5f, 0.9f, seed, threads).minimize(initial_population, f, 1.e-6f, logger); });
+	test_method("DE best/1/bin", function, [&] (const auto& f) {
+		return opt::DifferentialEvolution(iters, opt::DEStrategy::best_1_bin, 0.5f, 0.9f, seed, threads).minimize(initial_population, f, 1.e-6f, logger); });
+	test_method("JADE", function, [&] (const auto& f) {
+		return opt::DifferentialEvolution(iters, opt::DEStrategy::current_to_pbest_1_bin, 0.5f, 0.5f, seed, threads).minimize(initial_population, f, 1.e-6f, logger); });
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters = 3000;
+	unsigned long seed = (std::random_device())();
+	unsigned int threads = 1;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)   iters = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0) threads = atoi(argv[++i]);
+	}
+	test("Sphere", testfunction::sphere<30>(), iters, seed, threads);
+	test("Rosenbrock", testfunction::rosenbrock_n<10>(), iters, seed, threads);
+	test("Rastrigin", testfunction::rastrigin<10>(), iters, seed, threads);
+
+	//Through opt::minimize, with a random initial population
+	std::array<float,4> x = opt::minimize([] (const std::array<float,4>& x) {
+			float s = 0.0f;
+			for (std::size_t i = 0; i < x.size(); ++i) s += (x[i] - float(i))*(x[i] - float(i));
+			return s; }, opt::differential_evolution(iters, opt::DEStrategy::current_to_pbest_1_bin, 0.5f, 0.5f, seed, threads));
+	std::cout<<"opt::minimize: ["<<x[0]<<" "<<x[1]<<" "<<x[2]<<" "<<x[3]<<"] should be close to [0 1 2 3]"<<std::endl;
+}
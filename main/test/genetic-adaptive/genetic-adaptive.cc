@@ -0,0 +1,67 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+//GeneticBest keeps a hash table of the population
+namespace std {
+    template <size_t N> struct hash<std::array<float,N>>
+    {
+        size_t operator()(const std::array<float,N>& a) const
+        {
+			size_t seed = 0;
+			for (float f : a) seed ^= std::hash<float>()(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+        }
+    };
+}
+
+template<typename F, typename Run>
+void test_method(const char* name, const F& function, const Run& run) {
+	testfunction::counted<F> f(function);
+	auto sol = run(f);
+	std::cout<<std::setw(36)<<name<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<"\t| Value at result = "<<std::setw(10)<<function(sol)<<std::endl;
+}
+
+template<typename Function>
+void test(const char* title, const Function& function, float stddev, unsigned long iters, unsigned long seed) {
+	constexpr std::size_t N = Function::dimension;
+	std::cout<<title<<", dimension "<<N<<std::endl;
+	std::mt19937 random(seed);
+	auto initial_population = opt::initialization::population(20,
+			opt::initialization::array<N>(opt::initialization::real_uniform(random, function.lower(), function.upper())));
+	auto adaptive_population = opt::initialization::population(20,
+			opt::initialization::self_adaptive(opt::initialization::array<N>(opt::initialization::real_uniform(random, function.lower(), function.upper())), stddev));
+	float threshold = function.minimum() + 1.e-4f;
+	auto crossover = opt::crossover::vector_onepoint();
+	opt::GeneticStochasticBest stochastic(iters, 20, 20, 20, seed);
+	opt::GeneticBest best(iters, 5, 30, 10, 10, seed);
+
+	test_method("StochasticBest, fixed normal", function, [&] (const auto& f) {
+		auto logger = opt::genetic_logger::null();
+		return stochastic.minimize(initial_population, f, opt::mutation::vector_all(opt::mutation::real_normal(stddev)), crossover, threshold, logger); });
+	test_method("StochasticBest, 1/5th success rule", function, [&] (const auto& f) {
+		auto logger = opt::genetic_logger::null();
+		return stochastic.minimize(initial_population, f, opt::mutation::vector_all(opt::mutation::real_normal_adaptive(stddev)), crossover, threshold, logger); });
+	test_method("Best, fixed normal", function, [&] (const auto& f) {
+		auto logger = opt::genetic_logger::null();
+		return best.minimize(initial_population, f, opt::mutation::vector_all(opt::mutation::real_normal(stddev)), crossover, threshold, logger); });
+	test_method("Best, 1/5th success rule", function, [&] (const auto& f) {
+		auto logger = opt::genetic_logger::null();
+		return best.minimize(initial_population, f, opt::mutation::vector_all(opt::mutation::real_normal_adaptive(stddev)), crossover, threshold, logger); });
+	test_method("Best, self-adaptive", function, [&] (const auto& f) {
+		auto logger = opt::genetic_logger::null();
+		return best.minimize(adaptive_population, f, opt::mutation::self_adaptive(), opt::crossover::self_adaptive(crossover), threshold, logger).x; });
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters = 5000;
+	unsigned long seed = (std::random_device())();
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0) iters = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)  seed = atol(argv[++i]);
+	}
+	test("Sphere", testfunction::sphere<10>(), 0.1f, iters, seed);
+	test("Rosenbrock", testfunction::rosenbrock_n<10>(), 0.1f, iters, seed);
+}
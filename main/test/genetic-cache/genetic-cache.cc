@@ -0,0 +1,86 @@
+#include "../../../opt.h"
+#include "../../../utils/fitness-cache.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+
+//Integer objective (distance to a target value) with some artificial work per evaluation
+class SlowDistance {
+	int target;
+	unsigned int work;
+	std::shared_ptr<std::atomic<unsigned long>> calls;
+public:
+	SlowDistance(int target, unsigned int work) : target(target), work(work), calls(std::make_shared<std::atomic<unsigned long>>(0)) { }
+	float operator()(int x) const {
+		++(*calls);
+		float noise = 0.0f;
+		for (unsigned int w = 0; w < work; ++w) noise += std::sin(noise + w);
+		return std::abs(float(x) - float(target)) + 1.e-30f*noise;
+	}
+	unsigned long evaluations() const { return *calls; }
+};
+
+template<typename Method, typename Logger>
+void test_method(const char* name, const Method& method, Logger& logger, unsigned int work, std::size_t capacity, unsigned long seed) {
+	std::mt19937 random(seed);
+	auto ini = opt::initialization::population(20, opt::initialization::int_uniform(random, -1000, 1000));
+	for (bool use_cache : {false, true}) {
+		SlowDistance f(123, work);
+		opt::fitness_cache<int, SlowDistance> cache(f, capacity);
+		auto start = std::chrono::steady_clock::now();
+		int sol;
+		if (use_cache) sol = method.minimize(ini, cache, opt::mutation::bit32_swap(), opt::crossover::bit32_onepoint(), 0.0f, logger);
+		else           sol = method.minimize(ini, f, opt::mutation::bit32_swap(), opt::crossover::bit32_onepoint(), 0.0f, logger);
+		auto stop = std::chrono::steady_clock::now();
+		std::chrono::duration<float> duration = stop - start;
+		std::cout<<std::setw(16)<<name<<(use_cache?" (cache)":"        ")<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()
+		         <<" sec.\t| Result = "<<std::setw(6)<<sol<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations();
+		if (use_cache) std::cout<<"\t| Hits = "<<cache.hits()<<" ("<<(100.0f*cache.hits())/float(cache.hits() + cache.misses())<<" %)";
+		std::cout<<std::endl;
+	}
+}
+
+//Same objective for a whole population at once
+struct SlowDistanceBatch {
+	SlowDistance f;
+	void operator()(opt::span<const int> x, opt::span<float> y) const {
+		for (std::size_t i = 0; i < x.size(); ++i) y[i] = f(x[i]);
+	}
+};
+
+int main(int argc, char** argv) {
+	unsigned int iters     = 1000;
+	unsigned int work      = 1000;
+	std::size_t  capacity  = 10000;
+	unsigned long seed     = (std::random_device())();
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)    iters = atoi(argv[++i]);
+		else if (strcmp("-work", argv[i])==0)     work = atoi(argv[++i]);
+		else if (strcmp("-capacity", argv[i])==0) capacity = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)     seed = atol(argv[++i]);
+	}
+
+	auto logger = opt::genetic_logger::null();
+	test_method("Stochastic", opt::GeneticStochastic(iters, 20, 20, 20, seed), logger, work, capacity, seed);
+	test_method("StochasticBest", opt::GeneticStochasticBest(iters, 20, 20, 20, seed), logger, work, capacity, seed);
+
+	//The parameter type of a cached function is deduced, as that of any other function
+	SlowDistance f(123, work);
+	auto cache = opt::cached(f, capacity);
+	int sol = opt::minimize(cache, opt::genetic(iters, 20, 20, 20, seed), opt::mutation::bit32_swap(), opt::crossover::bit32_onepoint());
+	std::cout<<std::setw(16)<<"minimize (cache)"<<"\t| Result = "<<std::setw(6)<<sol<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()
+	         <<"\t| Hits = "<<cache.hits()<<std::endl;
+
+	//Only the elements that are not cached are passed to a batch function
+	SlowDistanceBatch g{SlowDistance(123, work)};
+	opt::fitness_cache<int, SlowDistanceBatch> batch(g, capacity);
+	std::mt19937 random(seed);
+	sol = opt::genetic(iters, 20, 20, 20, seed).minimize(opt::initialization::population(20, opt::initialization::int_uniform(random, -1000, 1000)),
+		batch, opt::mutation::bit32_swap(), opt::crossover::bit32_onepoint(), 0.0f, logger);
+	std::cout<<std::setw(16)<<"Batch (cache)"<<"\t| Result = "<<std::setw(6)<<sol<<"\t| Evaluations = "<<std::setw(8)<<g.f.evaluations()
+	         <<"\t| Hits = "<<batch.hits()<<std::endl;
+}
@@ -0,0 +1,87 @@
+#include "../../../opt.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <set>
+
+//Rastrigin function: many local minima, global minimum 0 at the origin
+float rastrigin(const std::array<float,6>& x) {
+	float s = 10.0f*x.size();
+	for (float xi : x) s += xi*xi - 10.0f*std::cos(2.0f*float(M_PI)*xi);
+	return s;
+}
+
+template<typename Method>
+void test_method(const char* name, const Method& method, unsigned long seed) {
+	auto logger = opt::genetic_logger::null();
+	std::mt19937 random(seed);
+	auto start = std::chrono::steady_clock::now();
+	std::array<float,6> sol = method.minimize(
+		opt::initialization::population(100, opt::initialization::array<6>(opt::initialization::real_uniform(random, -5.0f, 5.0f))),
+		rastrigin, opt::mutation::vector_single(opt::mutation::real_normal(0.2f)), opt::crossover::vector_uniform(), 1.e-6f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(24)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<rastrigin(sol)<<std::endl;
+}
+
+//Number of different genomes in a population
+std::size_t distinct(const opt::Population<std::array<float,6>, float>& population) {
+	std::set<std::array<float,6>> genomes;
+	for (std::size_t i = 0; i < population.size(); ++i) genomes.insert(population.x(i));
+	return genomes.size();
+}
+
+//Each epoch continues from the selected population of the previous one. Without improvement (a flat function and
+//epochs without iterations) its diversity must not fall, as it is not selected again (which, with replacement,
+//would drop individuals at each epoch).
+bool diversity_across_epochs(unsigned int epochs, unsigned long seed) {
+	auto logger = opt::genetic_logger::null();
+	auto flat = [] (const std::array<float,6>&) { return 1.0f; };
+	auto mutate = opt::mutation::vector_single(opt::mutation::real_normal(0.2f));
+	auto cross = opt::crossover::vector_uniform();
+	opt::GeneticStochasticBest engine(0, 20, 20, 40, seed, 1, opt::SelectionPolicy::discrete);
+	std::mt19937 random(seed);
+	auto ini = opt::initialization::population(20, opt::initialization::array<6>(opt::initialization::real_uniform(random, -5.0f, 5.0f)));
+	opt::Population<std::array<float,6>, float> initial(ini.begin(), ini.end());
+	for (std::size_t i = 0; i < initial.size(); ++i) initial.y(i) = flat(initial.x(i));
+
+	auto population = engine.evolve(initial, flat, mutate, cross, -1.0f, logger, 0, seed);
+	auto reselected = population;
+	std::size_t first = distinct(population);
+	for (unsigned int epoch = 1; epoch <= epochs; ++epoch) {
+		population = engine.evolve(population, flat, mutate, cross, -1.0f, logger, 0, seed + epoch, true);
+		reselected = engine.evolve(reselected, flat, mutate, cross, -1.0f, logger, 0, seed + epoch, false);
+	}
+	bool kept = (distinct(population) >= first);
+	std::cout<<"Diversity after "<<epochs<<" epochs\t| Distinct = "<<first<<" -> "<<distinct(population)
+	         <<" (selecting again each epoch: "<<distinct(reselected)<<")\t| "<<(kept?"OK":"LOST")<<std::endl;
+	return kept;
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters     = 2000;
+	unsigned int  islands   = 4;
+	unsigned long interval  = 100;
+	unsigned int  migrants  = 2;
+	unsigned int  threads   = 0;
+	unsigned long seed      = (std::random_device())();
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)     iters = atol(argv[++i]);
+		else if (strcmp("-islands", argv[i])==0)   islands = atoi(argv[++i]);
+		else if (strcmp("-interval", argv[i])==0)  interval = atol(argv[++i]);
+		else if (strcmp("-migrants", argv[i])==0)  migrants = atoi(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0)   threads = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)      seed = atol(argv[++i]);
+	}
+
+	//Same number of evaluations: the single population is as large as all the islands together
+	opt::GeneticStochasticBest single(iters, 20*islands, 20*islands, 40*islands, seed, 1, opt::SelectionPolicy::universal);
+	opt::GeneticStochasticBest island(iters, 20, 20, 40, seed, 1, opt::SelectionPolicy::universal);
+	test_method("Single population", single, seed);
+	test_method("Islands", opt::islands(island, islands, interval, migrants, threads, seed), seed);
+	test_method("Islands (no migration)", opt::islands(island, islands, interval, 0, threads, seed), seed);
+	return diversity_across_epochs(20, seed)?0:1;
+}
@@ -0,0 +1,80 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+std::ostream& operator<<(std::ostream& os, const std::array<float,2>& a) {
+	os<<" <"<<a[0]<<" , "<<a[1]<<"> ";
+	return os;
+}
+
+//Rosenbrock that takes a while to evaluate, mimicking an expensive simulation
+class SlowRosenbrock {
+	testfunction::rosenbrock f;
+	unsigned int work;
+public:
+	SlowRosenbrock(unsigned int work) : work(work) { }
+	float operator()(const std::array<float,2>& x) const {
+		volatile float sink = 0.0f;
+		for (unsigned int i = 0; i < work; ++i) sink = sink + f(x)*1.e-9f;
+		return f(x);
+	}
+};
+
+std::array<float,2> test_threads(unsigned int threads, const SlowRosenbrock& f, unsigned int iters, unsigned int population, unsigned int mutations, unsigned int crossovers, unsigned long seed) {
+	auto logger = opt::genetic_logger::null();
+	std::mt19937 random;
+	opt::GeneticStochasticBest method(iters, population, mutations, crossovers, seed, threads);
+	auto start = std::chrono::steady_clock::now();
+	std::array<float,2> sol = method.minimize(
+			opt::initialization::population(100,
+					opt::initialization::array<2>(opt::initialization::real_uniform(random, -100.0f, 100.0f))),
+			f,
+			opt::mutation::vector_single(opt::mutation::real_normal(1.0f)),
+			opt::crossover::vector_onepoint(),
+			1.e-4f,
+			logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<"Threads = "<<std::setw(3)<<threads<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = "
+						<<sol<<std::endl;
+	return sol;
+}
+
+int main(int argc, char** argv) {
+	unsigned int iters = 100;
+	unsigned long seed = (std::random_device())();
+	unsigned int population = 20;
+	unsigned int mutations  = 20;
+	unsigned int crossovers = 40;
+	unsigned int work       = 100000;
+	unsigned int max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0) iters = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)       seed = atol(argv[++i]);
+		else if (strcmp("-population", argv[i])==0) population = atoi(argv[++i]);
+		else if (strcmp("-mutations", argv[i])==0)  mutations = atoi(argv[++i]);
+		else if (strcmp("-crossovers", argv[i])==0) crossovers = atoi(argv[++i]);
+		else if (strcmp("-work", argv[i])==0)       work = atoi(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0)    max_threads = atoi(argv[++i]);
+	}
+
+	//Any number of threads other than one gives the same result, different from the sequential one, also the
+	//hardware concurrency (0) on a single core machine.
+	SlowRosenbrock f(work);
+	test_threads(1, f, iters, population, mutations, crossovers, seed); //For comparison
+	std::array<float,2> parallel   = test_threads(2, f, iters, population, mutations, crossovers, seed);
+	std::vector<unsigned int> counts{0, 3, 7};
+	for (unsigned int threads = 4; threads <= max_threads; threads *= 2) counts.push_back(threads);
+	bool reproducible = true;
+	for (unsigned int threads : counts) {
+		reproducible = (test_threads(threads, f, iters, population, mutations, crossovers, seed) == parallel) && reproducible;
+	}
+	std::cout<<"Parallel runs are "<<(reproducible?"":"NOT ")<<"reproducible"<<std::endl;
+	return reproducible?0:1;
+}
@@ -36,6 +36,33 @@ public:
 	}
 };
 
+//Same comparison for a whole population at once: the samples are generated only once per batch.
+template<typename F>
+class PolynomialCompareBatch {
+	F f; float xmin; float xmax; unsigned int nsamples; unsigned long seed;
+public:
+	PolynomialCompareBatch(const F& f, float xmin = 0.0f, float xmax = 1.0f, unsigned int nsamples = 100, unsigned long seed = (std::random_device())()) :
+		f(f), xmin(xmin), xmax(xmax), nsamples(nsamples), seed(seed) { }
+
+	void operator()(opt::span<const std::vector<float>> ps, opt::span<float> errors) const {
+		std::mt19937 random(seed);
+		std::uniform_real_distribution sample(xmin, xmax);
+		std::vector<float> xs(nsamples), fxs(nsamples);
+		for (unsigned int i = 0; i<nsamples; ++i) {
+			xs[i] = sample(random);
+			fxs[i] = f(xs[i]);
+		}
+		for (std::size_t j = 0; j<ps.size(); ++j) {
+			float sum = 0.0f;
+			for (unsigned int i = 0; i<nsamples; ++i) {
+				float e = fxs[i] - eval(ps[j],xs[i]);
+				sum += e*e;
+			}
+			errors[j] = sum/float(nsamples);
+		}
+	}
+};
+
 template<typename FMutation, typename X>
 class AddAndMutate {
 	FMutation mutate_default;
@@ -77,4 +104,16 @@ int main(int argc, char** argv) {
 
 	for (float coef : polynomial) std::cout<<coef<<" ";
 	std::cout<<std::endl;
+
+	//The batch version is called directly on the method, with explicit initial population and operators
+	std::mt19937 random;
+	auto logger = opt::genetic_logger::null();
+	polynomial = opt::genetic().minimize(
+			opt::initialization::population(100, opt::init_default<std::vector<float>>::strategy(random)),
+			PolynomialCompareBatch([] (float x) { return x*x - 2.0f*x + 1.0f; }), 
+			AddAndMutate(opt::mutation::vector_single(opt::mutation::real_normal(1.0f)), 1.0f),
+			opt::crossover::vector_onepoint(), 1.e-10f, logger);
+
+	for (float coef : polynomial) std::cout<<coef<<" ";
+	std::cout<<std::endl;
 }
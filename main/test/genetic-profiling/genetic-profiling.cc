@@ -0,0 +1,32 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include "../../../utils/allocation-counter.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+//Writes the profile of each generation of the genetic method as CSV (to the standard output or to a file),
+//so that the time spent on each stage and the allocations can be plotted along the optimization
+int main(int argc, char** argv) {
+	unsigned int generations = 100;
+	unsigned long seed = (std::random_device())();
+	unsigned int threads = 1;
+	const char* output = nullptr;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-generations", argv[i])==0)   generations = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0) threads = atoi(argv[++i]);
+		else if (strcmp("-output", argv[i])==0)  output = argv[++i];
+	}
+
+	testfunction::rosenbrock_n<10> f;
+	std::mt19937 random(seed);
+	std::ofstream file;
+	if (output) file.open(output);
+	std::ostream& os = output?file:std::cout;
+	auto logger = opt::genetic_logger::profile(os);
+	std::array<float,10> sol = opt::GeneticStochasticBest(generations, 50, 50, 100, seed, threads).minimize(
+			opt::initialization::population(100, opt::initialization::array<10>(opt::initialization::real_uniform(random, -2.0f, 2.0f))),
+			f, opt::mutation::vector_single(opt::mutation::real_normal(0.05f)), opt::crossover::vector_onepoint(), 0.0f, logger);
+	std::cerr<<"Error = "<<f.error(sol)<<" %"<<std::endl;
+}
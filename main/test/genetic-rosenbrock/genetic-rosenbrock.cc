@@ -1,5 +1,4 @@
 #include "../../../opt.h"
-#include "../../../utils/null-ostream.h"
 #include "../../../utils/test-functions.h"
 #include <iostream>
 #include <cstring>
@@ -0,0 +1,47 @@
+#include "../../../opt.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+//Time per iteration of GeneticStochasticBest with a cheap objective, where selection dominates
+float time_per_iteration(opt::SelectionPolicy policy, unsigned int population, unsigned int iters, unsigned long seed) {
+	auto logger = opt::genetic_logger::null();
+	std::mt19937 random(seed);
+	opt::GeneticStochasticBest method(iters, population, population, 2*population, seed, 1, policy);
+	auto start = std::chrono::steady_clock::now();
+	method.minimize(opt::initialization::population(population,
+					opt::initialization::array<2>(opt::initialization::real_uniform(random, -100.0f, 100.0f))),
+			[] (const std::array<float,2>& x) { return x[0]*x[0] + x[1]*x[1]; },
+			opt::mutation::vector_single(opt::mutation::real_normal(1.0f)),
+			opt::crossover::vector_onepoint(),
+			-1.0f, //Never reached, so that all iterations are run
+			logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	return duration.count()/float(iters);
+}
+
+int main(int argc, char** argv) {
+	unsigned int iters = 5;
+	unsigned long seed = (std::random_device())();
+	unsigned int max_population = 100000;
+	unsigned int max_discrete   = 10000; //The original selection is quadratic, so it is skipped for large populations
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)          iters = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)           seed = atol(argv[++i]);
+		else if (strcmp("-max-population", argv[i])==0) max_population = atoi(argv[++i]);
+		else if (strcmp("-max-discrete", argv[i])==0)   max_discrete = atoi(argv[++i]);
+	}
+
+	std::cout<<std::setw(12)<<"Population"<<std::setw(16)<<"discrete"<<std::setw(16)<<"weighted"<<std::setw(16)<<"universal"<<"   (sec. per iteration)"<<std::endl;
+	for (unsigned int population : {20u, 100u, 1000u, 10000u, 100000u}) {
+		if (population > max_population) break;
+		std::cout<<std::setw(12)<<population<<std::setprecision(3);
+		if (population <= max_discrete) std::cout<<std::setw(16)<<time_per_iteration(opt::SelectionPolicy::discrete, population, iters, seed);
+		else                            std::cout<<std::setw(16)<<"-";
+		std::cout<<std::setw(16)<<time_per_iteration(opt::SelectionPolicy::weighted, population, iters, seed);
+		std::cout<<std::setw(16)<<time_per_iteration(opt::SelectionPolicy::universal, population, iters, seed)<<std::endl;
+	}
+}
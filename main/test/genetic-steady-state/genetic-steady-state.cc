@@ -0,0 +1,60 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+//Rosenbrock whose evaluation takes between 1 and "slowest" times "work" microseconds (depending on the position),
+//mimicking simulations whose running time varies a lot
+class VariableRosenbrock {
+	testfunction::rosenbrock_n<4> f;
+	unsigned int work, slowest;
+	std::shared_ptr<std::atomic<unsigned long>> values;
+public:
+	VariableRosenbrock(unsigned int work, unsigned int slowest) : work(work), slowest(slowest), values(std::make_shared<std::atomic<unsigned long>>(0)) { }
+	float operator()(const std::array<float,4>& x) const {
+		++(*values);
+		std::size_t h = opt::genome_hash<std::array<float,4>>()(x);
+		unsigned int factor = ((h % 10) == 0)?slowest:1; //One in ten evaluations is slow
+		std::this_thread::sleep_for(std::chrono::microseconds(work*factor));
+		return f(x);
+	}
+	unsigned long evaluations() const { return *values; }
+	float error(const std::array<float,4>& x) const { return f.error(x); }
+};
+
+template<typename Method>
+void test_method(const char* name, const Method& method, unsigned int work, unsigned int slowest, unsigned long seed) {
+	VariableRosenbrock f(work, slowest);
+	std::mt19937 random(seed);
+	auto logger = opt::genetic_logger::null();
+	auto start = std::chrono::steady_clock::now();
+	std::array<float,4> sol = method.minimize(
+			opt::initialization::population(60, opt::initialization::array<4>(opt::initialization::real_uniform(random, -2.0f, 2.0f))),
+			f, opt::mutation::vector_single(opt::mutation::real_normal(0.05f)), opt::crossover::vector_onepoint(), 0.0f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Error = "<<std::setw(10)<<f.error(sol)
+		<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<std::endl;
+}
+
+int main(int argc, char** argv) {
+	unsigned int generations = 100;
+	unsigned long seed = (std::random_device())();
+	unsigned int threads = 8;
+	unsigned int work = 200;
+	unsigned int slowest = 50;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-generations", argv[i])==0)   generations = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0) threads = atoi(argv[++i]);
+		else if (strcmp("-work", argv[i])==0)    work = atoi(argv[++i]);
+		else if (strcmp("-slowest", argv[i])==0) slowest = atoi(argv[++i]);
+	}
+	std::cout<<threads<<" threads, evaluations take "<<work<<" or "<<work*slowest<<" microseconds"<<std::endl;
+	//The same number of evaluations for both: 60 per generation
+	test_method("StochasticBest", opt::GeneticStochasticBest(generations, 20, 20, 40, seed, threads), work, slowest, seed);
+	test_method("SteadyState", opt::GeneticSteadyState(60*generations, 20, 2.0f/3.0f, 2, seed, threads), work, slowest, seed);
+}
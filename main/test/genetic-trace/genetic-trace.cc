@@ -0,0 +1,77 @@
+#include "../../../opt.h"
+#include "../../../methods/genetic/trace-logger.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <iterator>
+#include <chrono>
+
+//Traces a long run into a binary file and reads it back, comparing the cost per generation of the trace with
+//that of writing the population as text
+int main(int argc, char** argv) {
+	unsigned int generations = 10000;
+	unsigned long seed = (std::random_device())();
+	std::string path = "genetic-trace.trace";
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-generations", argv[i])==0)   generations = atoi(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+		else if (strcmp("-output", argv[i])==0)  path = argv[++i];
+	}
+
+	testfunction::rosenbrock_n<10> f;
+	auto run = [&] (auto& logger) {
+		std::mt19937 random(seed);
+		auto start = std::chrono::steady_clock::now();
+		std::array<float,10> sol = opt::GeneticStochasticBest(generations, 20, 20, 40, seed).minimize(
+				opt::initialization::population(100, opt::initialization::array<10>(opt::initialization::real_uniform(random, -2.0f, 2.0f))),
+				f, opt::mutation::vector_single(opt::mutation::real_normal(0.05f)), opt::crossover::vector_onepoint(), 0.0f, logger);
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+		std::cout<<"Error = "<<std::setw(10)<<f.error(sol)<<" %\t| Time = "<<std::setw(10)<<duration.count()<<" sec."<<std::endl;
+		return sol;
+	};
+
+	std::cout<<std::setw(8)<<"Null"<<"\t| "; 
+	auto null = opt::genetic_logger::null();
+	run(null);
+	{
+		std::ofstream discarded("/dev/null");
+		auto stream = opt::genetic_logger::stream(discarded);
+		std::cout<<std::setw(8)<<"Stream"<<"\t| ";
+		run(stream);
+	}
+	std::array<float,10> sol;
+	{
+		auto trace = opt::genetic_logger::trace(path);
+		std::cout<<std::setw(8)<<"Trace"<<"\t| ";
+		sol = run(trace);
+	}
+
+	opt::trace_reader trace(path);
+	unsigned long records = 0, last = 0;
+	double best = std::numeric_limits<double>::infinity();
+	std::array<float,10> best_genome{};
+	for (const auto& record : trace) {
+		++records; last = record.iteration();
+		for (std::size_t i = 0; i < record.size(); ++i) if (record.fitness(i) < best) {
+			best = record.fitness(i);
+			best_genome = record.genome<std::array<float,10>>(i);
+		}
+	}
+	std::cout<<records<<" records (last iteration "<<last<<"), best traced value "<<best<<" ("<<f(sol)<<" returned)"<<std::endl;
+	std::cout<<"The best traced individual is "<<((best_genome == sol)?"":"NOT ")<<"the result"<<std::endl;
+
+	//A trace cut in the middle of its last record (as if the disk had filled up) is read up to the previous one
+	std::string cut = path + ".cut";
+	{
+		std::ifstream is(path, std::ios::binary);
+		std::string bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+		std::ofstream(cut, std::ios::binary).write(bytes.data(), std::streamsize(bytes.size() - 12));
+	}
+	unsigned long cut_records = 0;
+	for (const auto& record : opt::trace_reader(cut)) { ++cut_records; (void)record; }
+	std::remove(cut.c_str());
+	std::cout<<"The cut trace has "<<cut_records<<" records"<<((cut_records + 1 == records)?"":" (WRONG)")<<std::endl;
+}
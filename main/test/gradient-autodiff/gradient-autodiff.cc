@@ -0,0 +1,100 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+/**
+ * Least squares calibration of a model y = p0 + p1*t + sum_k p_(k+2) * sin(k*t) against data generated with
+ * known parameters. Written for any scalar type T, calling the math functions unqualified.
+ **/
+template<std::size_t N>
+auto calibration(const std::vector<float>& t, const std::vector<float>& y) {
+	return [t, y] (const auto& p) {
+		using T = std::remove_cv_t<std::remove_reference_t<decltype(p[0])>>;
+		T error(0.0f);
+		for (std::size_t s = 0; s < t.size(); ++s) {
+			T model = p[0] + p[1]*t[s];
+			for (std::size_t k = 2; k < N; ++k) model += p[k]*std::sin(float(k)*t[s]);
+			T r = model - y[s];
+			error += r*r;
+		}
+		return error/float(t.size());
+	};
+}
+
+template<std::size_t N, typename F, typename Method>
+void test_method(const char* name, const F& function, const Method& method) {
+	testfunction::counted<F> counted(function);
+	std::array<float,N> ini; ini.fill(0.0f);
+	auto logger = opt::pattern_search_logger::null();
+	auto start = std::chrono::steady_clock::now();
+	auto sol = method.minimize(ini, counted, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Evaluations = "<<std::setw(8)<<counted.evaluations()<<std::endl;
+}
+
+//Extended Rosenbrock function written generically on the scalar type, without gradient
+template<std::size_t N>
+struct generic_rosenbrock {
+	template<typename V>
+	auto operator()(const V& v) const {
+		using T = std::remove_cv_t<std::remove_reference_t<decltype(v[0])>>;
+		T s(0.0f);
+		for (std::size_t i = 0; i < N; i += 2) s += (1.0f - v[i])*(1.0f - v[i]) + 100.0f*(v[i+1] - v[i]*v[i])*(v[i+1] - v[i]*v[i]);
+		return s;
+	}
+};
+
+template<std::size_t N>
+void test_gradients() {
+	testfunction::rosenbrock_n<N> analytic;
+	generic_rosenbrock<N> f;
+	std::array<float,N> x;
+	for (std::size_t i = 0; i < N; ++i) x[i] = 0.1f*float(i % 7) - 0.3f;
+	auto g = analytic.gradient(x);
+	auto gf = opt::forward_gradient(f, x);
+	auto gr = opt::reverse_gradient(f, x);
+	float ef = 0, er = 0;
+	for (std::size_t i = 0; i < N; ++i) { ef = std::max(ef, std::abs(gf[i] - g[i])); er = std::max(er, std::abs(gr[i] - g[i])); }
+	std::cout<<"Rosenbrock "<<N<<"D gradient error | forward = "<<ef<<"\t| reverse = "<<er<<std::endl;
+}
+
+template<std::size_t N>
+void test_calibration(unsigned int iters, float tolerance) {
+	std::vector<float> t, y;
+	for (int s = 0; s < 200; ++s) {
+		float ts = 0.05f*float(s);
+		float ys = 1.0f - 0.5f*ts;
+		for (std::size_t k = 2; k < N; ++k) ys += (1.0f/float(k))*std::sin(float(k)*ts);
+		t.push_back(ts); y.push_back(ys);
+	}
+	auto f = calibration<N>(t, y);
+	std::cout<<"Calibration, "<<N<<" parameters"<<std::endl;
+	test_method<N>("PatternSearch", f, opt::PatternSearch(100*iters, 1.0f, 1.e-6f));
+	test_method<N>("GradientDescent", f, opt::GradientDescent(100*iters, tolerance));
+	test_method<N>("L-BFGS", f, opt::LBFGS(iters, 8, tolerance));
+}
+
+int main(int argc, char** argv) {
+	unsigned int iters = 1000;
+	float tolerance = 1.e-4f;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)     iters = atoi(argv[++i]);
+		else if (strcmp("-tolerance", argv[i])==0) tolerance = atof(argv[++i]);
+	}
+	test_gradients<2>();
+	test_gradients<100>();
+	test_calibration<10>(iters, tolerance);
+	test_calibration<30>(iters, tolerance);
+
+	//Generic functions with a known parameter type are minimized with L-BFGS by default
+	auto paraboloid = opt::differentiable<std::array<float,2>>([] (const auto& x) { return (x[0] - 3.0f)*(x[0] - 3.0f) + 10.0f*(x[1] + 1.0f)*(x[1] + 1.0f); });
+	std::array<float,2> x = opt::minimize(paraboloid);
+	std::cout<<"["<<x[0]<<","<<x[1]<<"] should be close to [3,-1]"<<std::endl;
+}
@@ -0,0 +1,48 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+template<typename F, typename Method>
+void test_method(const char* name, const F& function, const Method& method) {
+	testfunction::counted<F> f(function);
+	auto logger = opt::pattern_search_logger::null();
+	std::array<float,F::dimension> ini; ini.fill(-1.0f);
+	auto start = std::chrono::steady_clock::now();
+	auto sol = method.minimize(ini, f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Error = "<<std::setw(10)<<function.error(sol)<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<" (+ "<<f.gradient_evaluations()<<" gradients)"<<std::endl;
+}
+
+template<std::size_t N>
+void test(unsigned int iters, float tolerance) {
+	std::cout<<"Rosenbrock, dimension "<<N<<std::endl;
+	testfunction::rosenbrock_n<N> f;
+	test_method("PatternSearch", f, opt::PatternSearch(100*iters, 1.0f, 1.e-6f));
+	test_method("GradientDescent", f, opt::GradientDescent(100*iters, tolerance));
+	test_method("L-BFGS", f, opt::LBFGS(iters, 8, tolerance));
+}
+
+int main(int argc, char** argv) {
+	unsigned int iters = 1000;
+	float tolerance = 1.e-4f;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)     iters = atoi(argv[++i]);
+		else if (strcmp("-tolerance", argv[i])==0) tolerance = atof(argv[++i]);
+	}
+	test<2>(iters, tolerance);
+	test<10>(iters, tolerance);
+	test<100>(iters, tolerance);
+
+	//Functions that provide their gradient are minimized with L-BFGS by default
+	struct Paraboloid {
+		float operator()(const std::array<float,2>& x) const { return (x[0] - 3.0f)*(x[0] - 3.0f) + 10.0f*(x[1] + 1.0f)*(x[1] + 1.0f); }
+		std::array<float,2> gradient(const std::array<float,2>& x) const { return std::array<float,2>{{2.0f*(x[0] - 3.0f), 20.0f*(x[1] + 1.0f)}}; }
+	};
+	std::array<float,2> x = opt::minimize(Paraboloid());
+	std::cout<<"["<<x[0]<<","<<x[1]<<"] should be close to [3,-1]"<<std::endl;
+}
@@ -0,0 +1,47 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+template<typename F, typename Method>
+void test_method(const char* name, const F& function, const Method& method) {
+	constexpr std::size_t N = F::dimension;
+	testfunction::counted<F> f(function);
+	std::array<float,N> ini; ini.fill(-1.0f);
+	auto logger = opt::pattern_search_logger::null();
+	auto start = std::chrono::steady_clock::now();
+	auto sol = method.minimize(ini, f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(16)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Error = "<<std::setw(10)<<function.error(sol)<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<std::endl;
+}
+
+template<typename Function>
+void test(const char* title, const Function& function, unsigned int iters) {
+	std::cout<<title<<", dimension "<<Function::dimension<<std::endl;
+	test_method("PatternSearch", function, opt::PatternSearch(iters, 1.0f, 1.e-6f));
+	test_method("NelderMead", function, opt::NelderMead(iters, 1.0f, 1.e-6f, false));
+	test_method("Adaptive NM", function, opt::NelderMead(iters, 1.0f, 1.e-6f, true));
+}
+
+int main(int argc, char** argv) {
+	unsigned int iters = 100000;
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)   iters = atoi(argv[++i]);
+	}
+	test("Sphere", testfunction::sphere<1>(), iters);
+	test("Rastrigin", testfunction::rastrigin<1>(), iters);
+	test("Rosenbrock", testfunction::rosenbrock_n<2>(), iters);
+	test("Rosenbrock", testfunction::rosenbrock_n<10>(), iters);
+	test("Sphere", testfunction::sphere<30>(), iters);
+
+	//Through opt::minimize, with a function of several parameters (Beale)
+	double x, y;
+	std::tie(x, y) = opt::minimize(
+		[] (double x, double y) { return std::pow(1.5-x+x*y,2) + std::pow(2.25-x+x*y*y,2) + std::pow(2.625-x+x*y*y*y,2); },
+		opt::nelder_mead(1000, 1.0f, 1.e-8f));
+	std::cout<<"Beale: ("<<x<<","<<y<<") should be (3,0.5)"<<std::endl;
+}
@@ -0,0 +1,51 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+
+//Rastrigin function: many local minima, global minimum 0 at the origin
+struct Rastrigin {
+	float operator()(const std::array<float,4>& x) const {
+		float s = 10.0f*x.size();
+		for (float xi : x) s += xi*xi - 10.0f*std::cos(2.0f*float(M_PI)*xi);
+		return s;
+	}
+};
+
+template<typename Method>
+void test_method(const char* name, const Method& method) {
+	Rastrigin function;
+	testfunction::counted<Rastrigin> f(function);
+	auto logger = opt::pattern_search_logger::null();
+	auto start = std::chrono::steady_clock::now();
+	std::array<float,4> sol = method.minimize(std::array<float,4>{3.2f,-2.1f,1.7f,-4.4f}, f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(24)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = <";
+	for (float xi : sol) std::cout<<" "<<xi;
+	std::cout<<" >\t| Value at result = "<<function(sol)<<"\t| Evaluations = "<<f.evaluations()<<std::endl;
+}
+
+int main(int argc, char** argv) {
+	unsigned int starts    = 64;
+	float        radius    = 4.0f;
+	unsigned int threads   = 0;
+	float        dominance = 1.0f;
+	unsigned long seed     = (std::random_device())();
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-starts", argv[i])==0)         starts = atoi(argv[++i]);
+		else if (strcmp("-radius", argv[i])==0)    radius = atof(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0)   threads = atoi(argv[++i]);
+		else if (strcmp("-dominance", argv[i])==0) dominance = atof(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)      seed = atol(argv[++i]);
+	}
+
+	opt::PatternSearch local(1000, 0.1f, 1.e-5f); //Small steps, so that each run stays in its basin
+	test_method("Single start", local);
+	test_method("Multi start", opt::multi_start(local, starts, radius, threads, -1.0f, seed));
+	test_method("Multi start (dominance)", opt::multi_start(local, starts, radius, threads, dominance, seed));
+}
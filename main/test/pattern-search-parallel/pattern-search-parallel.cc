@@ -0,0 +1,51 @@
+#include "../../../opt.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+//Shifted sphere with some artificial work per evaluation, so that the poll step dominates
+class SlowSphere {
+	unsigned int work;
+public:
+	SlowSphere(unsigned int work) : work(work) { }
+	float operator()(const std::vector<float>& x) const {
+		float s = 0.0f;
+		for (std::size_t i = 0; i < x.size(); ++i) s += (x[i] - 0.01f*i)*(x[i] - 0.01f*i);
+		float noise = 0.0f;
+		for (unsigned int w = 0; w < work; ++w) noise += std::sin(noise + w);
+		return s + 1.e-30f*noise;
+	}
+};
+
+std::vector<float> test_method(const char* name, const SlowSphere& f, unsigned int dimension, const opt::PatternSearch& method) {
+	auto logger = opt::pattern_search_logger::null();
+	auto start = std::chrono::steady_clock::now();
+	std::vector<float> sol = method.minimize(std::vector<float>(dimension, 0.0f), f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(28)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<f(sol)<<std::endl;
+	return sol;
+}
+
+int main(int argc, char** argv) {
+	unsigned int dimension = 200;
+	unsigned int iters     = 100;
+	unsigned int work      = 1000;
+	unsigned int threads   = std::max(2u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-dimension", argv[i])==0)       dimension = atoi(argv[++i]);
+		else if (strcmp("-iterations", argv[i])==0) iters = atoi(argv[++i]);
+		else if (strcmp("-work", argv[i])==0)       work = atoi(argv[++i]);
+		else if (strcmp("-threads", argv[i])==0)    threads = atoi(argv[++i]);
+	}
+
+	SlowSphere f(work);
+	std::vector<float> sequential = test_method("Sequential", f, dimension, opt::PatternSearch(iters, 1.0f, 1.e-3f));
+	std::vector<float> parallel   = test_method("Parallel poll", f, dimension, opt::PatternSearch(iters, 1.0f, 1.e-3f, threads));
+	test_method("Parallel opportunistic poll", f, dimension, opt::PatternSearch(iters, 1.0f, 1.e-3f, threads, true));
+	std::cout<<"Parallel poll "<<((sequential == parallel)?"matches":"DOES NOT match")<<" the sequential result"<<std::endl;
+}
@@ -1,5 +1,4 @@
 #include "../../../opt.h"
-#include "../../../utils/null-ostream.h"
 #include "../../../utils/test-functions.h"
 #include <iostream>
 #include <cstring>
@@ -12,11 +11,12 @@ std::ostream& operator<<(std::ostream& os, const std::array<float,2>& a) {
 
 template<typename Method>
 void test_method(const char* name, const testfunction::rosenbrock& f, const Method& method) {
+	auto logger = opt::pattern_search_logger::stream(std::cout);
 	auto start = std::chrono::system_clock::now();
 	std::array<float,2> sol = method.minimize(
 			std::array<float, 2>{0.0f,0.0f},
 			f, 
-			std::cout); 
+			logger); 
 	auto stop = std::chrono::system_clock::now();
 	std::chrono::duration<float> duration = stop - start;
 	std::cout<<std::setw(20)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Result = "
@@ -0,0 +1,120 @@
+#include "../../../utils/philox.h"
+#include "../../../utils/checkpoint.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <vector>
+
+//Known answers of Philox4x32-10 (from the Random123 distribution)
+bool known_answers() {
+	struct { opt::philox::counter_type counter; opt::philox::key_type key; opt::philox::counter_type expected; } tests[] = {
+		{ {0u, 0u, 0u, 0u}, {0u, 0u}, {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u} },
+		{ {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu}, {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu} },
+		{ {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u}, {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u} }
+	};
+	bool ok = true;
+	for (const auto& test : tests) {
+		opt::philox::counter_type result = opt::philox::block(test.counter, test.key);
+		std::cout<<"Known answer\t|";
+		for (auto r : result) std::cout<<" "<<std::hex<<std::setw(8)<<std::setfill('0')<<r;
+		std::cout<<std::dec<<std::setfill(' ');
+		bool right = (result == test.expected);
+		std::cout<<"\t| "<<(right?"OK":"WRONG")<<std::endl;
+		ok = ok && right;
+	}
+	return ok;
+}
+
+//Chi-square of the histogram of the uniform numbers drawn from consecutive streams (as the offspring slots do)
+double uniformity(unsigned long seed, unsigned int streams, unsigned int per_stream, unsigned int bins) {
+	std::vector<unsigned long> histogram(bins, 0);
+	std::uniform_int_distribution<unsigned int> bin(0, bins - 1);
+	for (unsigned int s = 0; s < streams; ++s) {
+		opt::philox random(seed, 1, s);
+		for (unsigned int i = 0; i < per_stream; ++i) ++histogram[bin(random)];
+	}
+	double expected = double(streams)*double(per_stream)/double(bins), chi2 = 0.0;
+	for (auto h : histogram) chi2 += (double(h) - expected)*(double(h) - expected)/expected;
+	return chi2;
+}
+
+//Time of creating a stream and drawing a few numbers from it, which is what each offspring slot does
+template<typename F>
+double nanoseconds(unsigned int streams, const F& draw) {
+	std::uint32_t sink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int s = 0; s < streams; ++s) sink ^= draw(s);
+	auto stop = std::chrono::steady_clock::now();
+	volatile std::uint32_t keep = sink; (void)keep;
+	return std::chrono::duration<double, std::nano>(stop - start).count()/double(streams);
+}
+
+int main(int argc, char** argv) {
+	unsigned long seed = 1;
+	unsigned int streams = 100000;
+	unsigned int draws = 8;
+
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-seed", argv[i])==0)         seed = atol(argv[++i]);
+		else if (strcmp("-streams", argv[i])==0) streams = atoi(argv[++i]);
+		else if (strcmp("-draws", argv[i])==0)   draws = atoi(argv[++i]);
+	}
+
+	bool ok = known_answers();
+
+	//Saving and restoring the state in the middle of a block, and skipping numbers, keep the sequence
+	opt::philox a(seed, 7, 3), b(seed, 7, 3);
+	for (int i = 0; i < 5; ++i) a();
+	std::stringstream state; state<<a;
+	opt::philox c; state>>c;
+	b.discard(5);
+	bool same = (a == c) && (a == b);
+	for (int i = 0; i < 10; ++i) { auto r = a(); same = same && (r == b()) && (r == c()); }
+	std::cout<<"Save, restore and discard\t| "<<(same?"OK":"WRONG")<<std::endl;
+	ok = ok && same;
+
+	//Checkpoints write the generator as text, in the middle of a block too
+	std::stringstream saved;
+	opt::checkpoint_format::write(saved, a);
+	opt::philox d; opt::checkpoint_format::read(saved, d);
+	bool restored = (a == d);
+	for (int i = 0; i < 10; ++i) restored = restored && (a() == d());
+	std::cout<<"Checkpoint\t| "<<(restored?"OK":"WRONG")<<std::endl;
+	ok = ok && restored;
+
+	//The block counter carries into its second word instead of cycling after 2^32 blocks (2^34 numbers)
+	opt::philox e(seed, 7, 3), f(seed, 7, 3);
+	e.discard(4ull << 32);
+	f.discard((4ull << 32) - 3); f(); f(); f(); //Up to the end of the block 2^32 - 1, so that the carry happens when drawing
+	std::uint32_t key[2] = {std::uint32_t(seed), std::uint32_t(std::uint64_t(seed) >> 32)};
+	opt::philox::counter_type next = opt::philox::block({0u, 1u, 3u, 7u}, {key[0], key[1]});
+	bool carried = true;
+	for (int i = 0; i < 4; ++i) { auto r = e(); carried = carried && (r == next[i]) && (r == f()); }
+	std::cout<<"Block counter carry\t| "<<(carried?"OK":"WRONG")<<std::endl;
+	ok = ok && carried;
+
+	//With 100 bins (99 degrees of freedom) the chi-square is below 135 with a 99% probability
+	double chi2 = uniformity(seed, streams, draws, 100);
+	std::cout<<"Chi-square of "<<streams<<" streams\t| "<<std::setprecision(4)<<chi2<<"\t| "<<((chi2 < 135.0)?"OK":"SUSPICIOUS")<<std::endl;
+
+	double philox_time = nanoseconds(streams, [&] (unsigned int s) {
+		opt::philox random(seed, 1, s);
+		std::uint32_t r = 0;
+		for (unsigned int i = 0; i < draws; ++i) r ^= random();
+		return r;
+	});
+	double mt_time = nanoseconds(streams, [&] (unsigned int s) {
+		std::seed_seq seq{std::uint32_t(seed), std::uint32_t(seed >> 32), 1u, 0u, s};
+		std::mt19937 random(seq);
+		std::uint32_t r = 0;
+		for (unsigned int i = 0; i < draws; ++i) r ^= random();
+		return r;
+	});
+	std::cout<<std::fixed<<std::setprecision(1)<<"Stream of "<<draws<<" numbers\t| philox = "<<std::setw(8)<<philox_time<<" ns ("<<sizeof(opt::philox)<<" bytes)"
+	         <<"\t| seed_seq + mt19937 = "<<std::setw(8)<<mt_time<<" ns ("<<sizeof(std::mt19937)<<" bytes)"<<std::endl;
+	return ok?0:1;
+}
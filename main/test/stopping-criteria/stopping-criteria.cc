@@ -0,0 +1,79 @@
+#include "../../../opt.h"
+#include "../../../utils/test-functions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+
+//Keeps the last iteration it was told about
+class last_iteration {
+public:
+	unsigned long iteration = 0;
+	template<typename Iterator>
+	void log(unsigned long i, const Iterator& begin, const Iterator& end) { iteration = i; }
+	template<typename XType, typename YType>
+	void log(unsigned long i, float step, const XType& best, const YType& f_best) { iteration = i; }
+};
+
+template<typename F, typename Run>
+void test_method(const char* name, const F& function, const Run& run) {
+	testfunction::counted<F> f(function);
+	last_iteration logger;
+	auto start = std::chrono::steady_clock::now();
+	auto sol = run(f, logger);
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<float> duration = stop - start;
+	std::cout<<std::setw(24)<<name<<"\t| Time = "<<std::setw(10)<<std::setprecision(3)<<duration.count()<<" sec.\t| Value at result = "<<std::setw(10)<<function(sol)
+		<<"\t| Iterations = "<<std::setw(8)<<logger.iteration<<"\t| Evaluations = "<<std::setw(8)<<f.evaluations()<<std::endl;
+}
+
+int main(int argc, char** argv) {
+	unsigned long iters = 100000;
+	unsigned long seed = (std::random_device())();
+	for (int i = 0; i<argc-1; ++i) {
+		if (strcmp("-iterations", argv[i])==0)   iters = atol(argv[++i]);
+		else if (strcmp("-seed", argv[i])==0)    seed = atol(argv[++i]);
+	}
+	constexpr std::size_t N = 10;
+	testfunction::rastrigin<N> function;
+	std::mt19937 random(seed);
+	auto initial_population = opt::initialization::population(50,
+			opt::initialization::array<N>(opt::initialization::real_uniform(random, function.lower(), function.upper())));
+	auto mutation = opt::mutation::vector_single(opt::mutation::real_normal(0.1f));
+	auto crossover = opt::crossover::vector_onepoint();
+
+	std::cout<<"Genetic algorithm on Rastrigin "<<N<<"D ("<<iters<<" iterations at most)"<<std::endl;
+	auto genetic = [&] (const char* name, const opt::stopping& stop) {
+		test_method(name, function, [&] (const auto& f, auto& logger) {
+			return opt::GeneticStochasticBest(iters, 50, 50, 50, seed, 1, opt::SelectionPolicy::discrete, stop).minimize(
+				initial_population, f, mutation, crossover, 0.0f, logger); });
+	};
+	genetic("No criteria", opt::stopping());
+	genetic("Time (0.5 sec.)", opt::stopping().time(0.5));
+	genetic("Evaluations (100000)", opt::stopping().evaluations(100000));
+	genetic("Stagnation (200)", opt::stopping().stagnation(200));
+	genetic("Stagnation (200, 1e-3)", opt::stopping().stagnation(200, 1.e-3));
+	genetic("Diversity (0.02)", opt::stopping().diversity(0.02));
+
+	//Each island checks the time and the evaluations of all the islands at every iteration, so the budget is
+	//exceeded by at most an iteration of each island (4x100 evaluations), not by a whole migration interval
+	std::cout<<"Island model on Rastrigin "<<N<<"D (4 islands, migrations every 1000 iterations)"<<std::endl;
+	auto islands = [&] (const char* name, const opt::stopping& stop) {
+		test_method(name, function, [&] (const auto& f, auto& logger) {
+			return opt::islands(opt::GeneticStochasticBest(iters, 50, 50, 50, seed, 1), 4, 1000, 2, 4, seed, stop).minimize(
+				initial_population, f, mutation, crossover, 0.0f, logger); });
+	};
+	islands("Time (0.5 sec.)", opt::stopping().time(0.5));
+	islands("Evaluations (100000)", opt::stopping().evaluations(100000));
+	islands("Stagnation (2000)", opt::stopping().stagnation(2000));
+
+	std::cout<<"Pattern search on Rastrigin "<<N<<"D"<<std::endl;
+	std::array<float,N> ini; ini.fill(2.5f);
+	auto pattern_search = [&] (const char* name, const opt::stopping& stop) {
+		test_method(name, function, [&] (const auto& f, auto& logger) {
+			return opt::PatternSearch(iters, 1.0f, 1.e-6f, 1, false, stop).minimize(ini, f, logger); });
+	};
+	pattern_search("No criteria", opt::stopping());
+	pattern_search("Evaluations (200)", opt::stopping().evaluations(200));
+	pattern_search("Stagnation (5)", opt::stopping().stagnation(5));
+}
@@ -0,0 +1,65 @@
+#include "../../../utils/trace.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+//Writes a summary of each iteration of a trace (see utils/trace.h) as CSV: iteration, individuals, best, mean and
+//worst value, and the genes of the best individual if the genomes are stored as arrays of floats or doubles
+int main(int argc, char** argv) {
+	const char* input = nullptr;
+	const char* output = nullptr;
+	const char* genes = "float";
+	unsigned long every = 1;
+	for (int i = 1; i<argc; ++i) {
+		if ((strcmp("-output", argv[i])==0) && (i+1<argc))     output = argv[++i];
+		else if ((strcmp("-every", argv[i])==0) && (i+1<argc)) every = std::max(1l, atol(argv[++i]));
+		else if ((strcmp("-genes", argv[i])==0) && (i+1<argc)) genes = argv[++i];
+		else input = argv[i];
+	}
+	if (!input) {
+		std::cerr<<"Usage: "<<argv[0]<<" <trace> [-output <csv>] [-every <iterations>] [-genes float|double|none]"<<std::endl;
+		return 1;
+	}
+
+	try {
+		opt::trace_reader trace(input);
+		std::ofstream file;
+		if (output) file.open(output);
+		std::ostream& os = output?file:std::cout;
+		std::size_t gene_size = (strcmp(genes, "double")==0)?sizeof(double):((strcmp(genes, "float")==0)?sizeof(float):0);
+		if ((gene_size > 0) && ((trace.genome_size() == 0) || ((trace.genome_size() % gene_size) != 0))) gene_size = 0;
+
+		os<<"iteration,individuals,best,mean,worst"<<(gene_size?",genes":"")<<std::endl;
+		os<<std::setprecision(std::numeric_limits<double>::max_digits10);
+		for (const auto& record : trace) {
+			if ((record.iteration() % every) != 0) continue;
+			double best = std::numeric_limits<double>::infinity(), worst = -best, sum = 0.0;
+			std::size_t ibest = 0, n = 0;
+			for (std::size_t i = 0; i < record.size(); ++i) {
+				double y = record.fitness(i);
+				if (std::isnan(y)) continue;
+				if (y < best) { best = y; ibest = i; }
+				if (y > worst) worst = y;
+				sum += y; ++n;
+			}
+			os<<record.iteration()<<","<<record.size()<<","<<best<<","<<(n?sum/double(n):std::nan(""))<<","<<worst;
+			if (gene_size && (record.size() > 0)) {
+				const char* g = static_cast<const char*>(record.genome_data(ibest));
+				os<<",";
+				for (std::size_t j = 0; j < trace.genome_size(); j += gene_size) {
+					double v;
+					if (gene_size == sizeof(float)) { float f; std::memcpy(&f, g + j, sizeof(f)); v = f; }
+					else std::memcpy(&v, g + j, sizeof(v));
+					os<<(j?" ":"")<<v;
+				}
+			}
+			os<<"\n";
+		}
+	} catch (const std::exception& e) {
+		std::cerr<<e.what()<<std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "../../utils/span.h"
+#include "../../utils/philox.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include "../genetic/evaluation.h"
+#include "../pattern-search/logger.h"
+#include "../pattern-search/concepts.h"
+#include "eigen.h"
+#include <type_traits>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Covariance Matrix Adaptation Evolution Strategy for continuous problems. Each generation samples lambda
+ * positions from a multivariate normal distribution, and moves its mean towards the best mu of them. The
+ * covariance matrix learns the shape of the function (rank one update from the evolution path and rank mu
+ * update from the selected steps) and the global step size is adapted from the length of the conjugate
+ * evolution path, so that ill-conditioned functions such as Rosenbrock are solved with far fewer
+ * evaluations than with isotropic mutations.
+ *
+ * Reference: N. Hansen, The CMA Evolution Strategy: A Tutorial (2016), arXiv:1604.00772
+ **/
+class CMAES
+{
+private:
+	unsigned long  iters_;			// maximum number of generations
+	float          sigma_;			// initial step size (standard deviation of the first generation)
+	unsigned int   lambda_;			// offspring per generation (0 = 4 + 3 ln(dimension), the usual default)
+	float          tolerance_;		// the method stops when the largest standard deviation is below this
+	unsigned int   nthreads_;		// number of threads for evaluating each generation (1 = sequential)
+	unsigned long  seed_;			// The seed for the random number generator (random by default)
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h, except diversity)
+
+public:
+	CMAES(unsigned long iters         = 1000,
+		float sigma                   = 1.0f,
+		unsigned int lambda           = 0,
+		float tolerance               = 1.e-6f,
+		unsigned int nthreads         = 1,
+		unsigned long seed = (std::random_device())(),
+		const stopping& stop          = stopping()) :
+		iters_(iters),
+		sigma_(sigma),
+		lambda_(lambda),
+		tolerance_(tolerance),
+		nthreads_(nthreads),
+		seed_(seed),
+		stop_(stop) {}
+
+	/**
+	 * Minimizes f starting with the distribution centered at ini. The positions are random access
+	 * collections of floating point numbers (internally the method works in double precision). Each
+	 * generation is evaluated in a single batch (see evaluation.h): the evaluations are spread over nthreads
+	 * threads, so f must be safe to call concurrently if nthreads > 1. The result does not depend on the number
+	 * of threads.
+	 * The logger receives, at each generation, the step size, the best position found so far and its value
+	 * (same interface as the pattern search loggers, see ../pattern-search/logger.h).
+	 **/
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 std::is_floating_point_v<std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<XType&>()))>>> &&
+	                 TargetFunction<FTarget, XType, YType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		return run<YType>(ini, f, logger);
+	}
+
+	/**
+	 * Same as above for a BatchTargetFunction, which gets each generation at once. The type of its values
+	 * cannot be deduced, so it is given explicitly, as in opt::cmaes().minimize<double>(ini, f, logger).
+	 **/
+	template<typename YType, typename XType, typename FTarget, typename Logger>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 std::is_floating_point_v<std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<XType&>()))>>> &&
+	                 BatchTargetFunction<FTarget, XType, YType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		return run<YType>(ini, f, logger);
+	}
+
+private:
+	template<typename YType, typename XType, typename FTarget, typename Logger>
+	XType run(const XType& ini, const FTarget& f, Logger& logger) const {
+		using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(ini))>>;
+		const std::size_t n = ini.size();
+		if (n == 0) return ini;
+		const double N = double(n);
+
+		//Strategy parameters (default values of the tutorial)
+		const std::size_t lambda = std::max<std::size_t>(2, (lambda_ > 0)?lambda_:(4 + std::size_t(3.0*std::log(N))));
+		const std::size_t mu = lambda/2;
+		std::vector<double> weights(mu);
+		for (std::size_t i = 0; i < mu; ++i) weights[i] = std::log(double(lambda + 1)/2.0) - std::log(double(i + 1));
+		double sum = std::accumulate(weights.begin(), weights.end(), 0.0), squares = 0.0;
+		for (double& w : weights) { w /= sum; squares += w*w; }
+		const double mueff = 1.0/squares;
+		const double cc = (4.0 + mueff/N)/(N + 4.0 + 2.0*mueff/N);
+		const double cs = (mueff + 2.0)/(N + mueff + 5.0);
+		const double c1 = 2.0/((N + 1.3)*(N + 1.3) + mueff);
+		const double cmu = std::min(1.0 - c1, 2.0*(mueff - 2.0 + 1.0/mueff)/((N + 2.0)*(N + 2.0) + mueff));
+		const double damps = 1.0 + 2.0*std::max(0.0, std::sqrt((mueff - 1.0)/(N + 1.0)) - 1.0) + cs;
+		const double chiN = std::sqrt(N)*(1.0 - 1.0/(4.0*N) + 1.0/(21.0*N*N));
+		const unsigned long eigen_interval = std::max(1ul, (unsigned long)(double(lambda)/((c1 + cmu)*N*10.0)));
+
+		//State of the distribution: mean, step size, covariance C = B*D^2*B' and evolution paths
+		std::vector<double> mean(n), pc(n, 0.0), ps(n, 0.0), D(n, 1.0), yw(n), zw(n), z(n);
+		std::vector<double> C(n*n, 0.0), B(n*n, 0.0), invsqrtC(n*n, 0.0), work(n*n), eigenvalues(n);
+		for (std::size_t i = 0; i < n; ++i) { C[i*n + i] = B[i*n + i] = invsqrtC[i*n + i] = 1.0; }
+		{ std::size_t i = 0; for (auto v : ini) mean[i++] = double(v); }
+		double sigma = double(sigma_);
+
+		//Each generation: the steps y (such that x = mean + sigma*y), the positions and their values
+		std::vector<double> y(lambda*n);
+		std::vector<XType>  x(lambda, ini);
+		std::vector<YType>  fitness(lambda);
+		std::vector<std::size_t> order(lambda);
+
+		stopping::monitor monitor = stop_.start();
+		XType best = ini;
+		YType f_best = evaluate<XType,YType>(f, ini);
+		monitor.evaluated(1);
+		if (std::isnan(f_best)) f_best = std::numeric_limits<YType>::infinity();
+		thread_pool pool(nthreads_);
+		philox random(seed_);
+		std::normal_distribution<double> normal;
+
+		for (unsigned long iter = 1; (iter <= iters_) && !monitor.stop(); ++iter) {
+			//Sampling
+			for (std::size_t k = 0; k < lambda; ++k) {
+				for (std::size_t j = 0; j < n; ++j) z[j] = D[j]*normal(random);
+				double* yk = &y[k*n];
+				auto xk = std::begin(x[k]);
+				for (std::size_t i = 0; i < n; ++i, ++xk) {
+					double s = 0.0;
+					for (std::size_t j = 0; j < n; ++j) s += B[i*n + j]*z[j];
+					yk[i] = s;
+					(*xk) = Real(mean[i] + sigma*s);
+				}
+			}
+			evaluate<XType,YType>(f, span<const XType>(x.data(), lambda), span<YType>(fitness.data(), lambda), pool);
+
+			//Ranking (NaN last, ties by index so that it is deterministic)
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&fitness] (std::size_t a, std::size_t b) {
+				return (!std::isnan(fitness[a])) && (std::isnan(fitness[b]) || (fitness[a] < fitness[b])); });
+			if (fitness[order[0]] < f_best) { best = x[order[0]]; f_best = fitness[order[0]]; }
+			monitor.evaluated(lambda);
+			monitor.iteration(f_best);
+			logger.log(iter, float(sigma), best, f_best);
+
+			//Mean: weighted recombination of the best mu steps
+			std::fill(yw.begin(), yw.end(), 0.0);
+			for (std::size_t k = 0; k < mu; ++k) {
+				const double* yk = &y[order[k]*n];
+				for (std::size_t i = 0; i < n; ++i) yw[i] += weights[k]*yk[i];
+			}
+			for (std::size_t i = 0; i < n; ++i) mean[i] += sigma*yw[i];
+
+			//Step size control: conjugate evolution path
+			double ps_norm = 0.0;
+			for (std::size_t i = 0; i < n; ++i) {
+				double s = 0.0;
+				for (std::size_t j = 0; j < n; ++j) s += invsqrtC[i*n + j]*yw[j];
+				zw[i] = s;
+			}
+			for (std::size_t i = 0; i < n; ++i) {
+				ps[i] = (1.0 - cs)*ps[i] + std::sqrt(cs*(2.0 - cs)*mueff)*zw[i];
+				ps_norm += ps[i]*ps[i];
+			}
+			ps_norm = std::sqrt(ps_norm);
+			bool hsig = ps_norm/std::sqrt(1.0 - std::pow(1.0 - cs, 2.0*double(iter)))/chiN < 1.4 + 2.0/(N + 1.0);
+
+			//Covariance: evolution path (rank one) and selected steps (rank mu)
+			for (std::size_t i = 0; i < n; ++i) pc[i] = (1.0 - cc)*pc[i] + (hsig?std::sqrt(cc*(2.0 - cc)*mueff):0.0)*yw[i];
+			double keep = 1.0 - c1 - cmu + (hsig?0.0:c1*cc*(2.0 - cc));
+			for (std::size_t i = 0; i < n; ++i) for (std::size_t j = 0; j <= i; ++j) {
+				double rankmu = 0.0;
+				for (std::size_t k = 0; k < mu; ++k) rankmu += weights[k]*y[order[k]*n + i]*y[order[k]*n + j];
+				C[i*n + j] = keep*C[i*n + j] + c1*pc[i]*pc[j] + cmu*rankmu;
+				C[j*n + i] = C[i*n + j];
+			}
+
+			sigma *= std::exp(std::min(1.0, (cs/damps)*(ps_norm/chiN - 1.0)));
+
+			//Decomposition of C, only every few generations as it is O(n^3)
+			if ((iter % eigen_interval) == 0) {
+				work = C;
+				detail::symmetric_eigen(n, work, eigenvalues, B);
+				for (std::size_t i = 0; i < n; ++i) D[i] = std::sqrt(std::max(eigenvalues[i], 1.e-300));
+				for (std::size_t i = 0; i < n; ++i) for (std::size_t j = 0; j < n; ++j) {
+					double s = 0.0;
+					for (std::size_t k = 0; k < n; ++k) s += B[i*n + k]*B[j*n + k]/D[k];
+					invsqrtC[i*n + j] = s;
+				}
+			}
+
+			//Stop when the distribution has collapsed or became numerically degenerate
+			double dmax = *std::max_element(D.begin(), D.end()), dmin = *std::min_element(D.begin(), D.end());
+			if ((sigma*dmax < double(tolerance_)) || (dmax > 1.e7*dmin) || !std::isfinite(sigma)) break;
+		}
+		return best;
+	}
+};
+
+CMAES cmaes(unsigned long iters = 1000, float sigma = 1.0f, unsigned int lambda = 0, float tolerance = 1.e-6f,
+	unsigned int nthreads = 1, unsigned long seed = (std::random_device())(), const stopping& stop = stopping()) {
+	return CMAES(iters, sigma, lambda, tolerance, nthreads, seed, stop);
+}
+
+} // namespace opt
+
+#include "../pattern-search/minimize.h"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+namespace opt {
+namespace detail {
+
+/**
+ * Eigendecomposition of the n x n symmetric matrix a (row major) by the cyclic Jacobi method: on return
+ * values holds the eigenvalues and the columns of vectors (row major) the corresponding eigenvectors.
+ * Accurate and simple, which is enough for the covariance matrices of CMA-ES as they are decomposed
+ * only every few generations. The matrix a is overwritten.
+ **/
+inline void symmetric_eigen(std::size_t n, std::vector<double>& a, std::vector<double>& values, std::vector<double>& vectors,
+	unsigned int max_sweeps = 50) {
+	vectors.assign(n*n, 0.0);
+	for (std::size_t i = 0; i < n; ++i) vectors[i*n + i] = 1.0;
+
+	for (unsigned int sweep = 0; sweep < max_sweeps; ++sweep) {
+		double off = 0.0, diagonal = 0.0;
+		for (std::size_t i = 0; i < n; ++i) {
+			diagonal += a[i*n + i]*a[i*n + i];
+			for (std::size_t j = i + 1; j < n; ++j) off += a[i*n + j]*a[i*n + j];
+		}
+		if (off <= 1.e-30*diagonal) break;
+
+		for (std::size_t p = 0; p < n; ++p) for (std::size_t q = p + 1; q < n; ++q) {
+			double apq = a[p*n + q];
+			if (apq == 0.0) continue;
+			//Rotation that zeroes a[p][q]
+			double theta = (a[q*n + q] - a[p*n + p])/(2.0*apq);
+			double t = ((theta >= 0.0)?1.0:-1.0)/(std::abs(theta) + std::sqrt(theta*theta + 1.0));
+			double c = 1.0/std::sqrt(t*t + 1.0), s = t*c;
+			for (std::size_t k = 0; k < n; ++k) {
+				double akp = a[k*n + p], akq = a[k*n + q];
+				a[k*n + p] = c*akp - s*akq;
+				a[k*n + q] = s*akp + c*akq;
+			}
+			for (std::size_t k = 0; k < n; ++k) {
+				double apk = a[p*n + k], aqk = a[q*n + k];
+				a[p*n + k] = c*apk - s*aqk;
+				a[q*n + k] = s*apk + c*aqk;
+			}
+			for (std::size_t k = 0; k < n; ++k) {
+				double vkp = vectors[k*n + p], vkq = vectors[k*n + q];
+				vectors[k*n + p] = c*vkp - s*vkq;
+				vectors[k*n + q] = s*vkp + c*vkq;
+			}
+		}
+	}
+	values.resize(n);
+	for (std::size_t i = 0; i < n; ++i) values[i] = a[i*n + i];
+}
+
+} // namespace detail
+} // namespace opt
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../genetic/logger.h"
+#include <array>
+#include <vector>
+#include <functional>
+
+namespace opt {
+
+//Population based methods that, as DifferentialEvolution, evolve a population of real vectors without user provided operators
+template <typename Method>
+concept bool DifferentialEvolutionMethod =
+    requires(const Method& m, std::function<float(const std::array<float,1>&)> target, const std::vector<std::array<float,1>>& init,
+             genetic_logger::null& logger, std::array<float,1> sol) {
+	sol = m.minimize(init, target, 0.0f, logger);
+    };
+
+} // namespace opt
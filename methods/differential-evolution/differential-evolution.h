@@ -0,0 +1,220 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include "../genetic/concepts.h"
+#include "../genetic/evaluation.h"
+#include "../genetic/population.h"
+#include "../genetic/logger.h"
+#include "concepts.h"
+#include <type_traits>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * How the mutant vector of each individual x_i is built from the population (and the trial vector then takes
+ * each gene from the mutant with probability CR, binomial crossover):
+ * - rand_1_bin:             v = x_r1 + F (x_r2 - x_r3), the classic robust strategy.
+ * - best_1_bin:             v = x_best + F (x_r1 - x_r2), which converges faster but is more greedy.
+ * - current_to_pbest_1_bin: v = x_i + F (x_pbest - x_i) + F (x_r1 - x_r2), where x_pbest is one of the best
+ *                           p*NP individuals and x_r2 may come from an archive of replaced parents. F and CR are
+ *                           adapted along the optimization from the values that produced improvements (JADE).
+ **/
+enum class DEStrategy { rand_1_bin, best_1_bin, current_to_pbest_1_bin };
+
+/**
+ * Differential evolution: each individual of the population competes with a trial vector built from the
+ * scaled differences between other individuals, so the steps adapt to the spread and orientation of the
+ * population. Works with random access containers of numbers (such as std::array or std::vector) as genomes.
+ *
+ * References: R. Storn and K. Price, Differential evolution - a simple and efficient heuristic for global
+ * optimization over continuous spaces (1997); J. Zhang and A. C. Sanderson, JADE: adaptive differential
+ * evolution with optional external archive (2009).
+ **/
+class DifferentialEvolution
+{
+private:
+	unsigned long  iters_;			// number of iterations (generations)
+	DEStrategy     strategy_;		// how mutant vectors are built
+	float          weight_;			// differential weight F (initial mean of F for current_to_pbest_1_bin)
+	float          crossover_rate_;	// crossover probability CR (initial mean of CR for current_to_pbest_1_bin)
+	unsigned long  seed_;			// The seed for the random number generator (random by default)
+	unsigned int   nthreads_;		// number of threads for building and evaluating trial vectors (1 = sequential)
+	float          pbest_;			// fraction of the best individuals for current_to_pbest_1_bin
+	float          adaptation_;		// learning rate of the means of F and CR for current_to_pbest_1_bin
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h)
+
+	// Independent random stream for each individual at each iteration when running in parallel, so that the
+	// result does not depend on the number of threads (nor on their scheduling). Philox streams cost nothing to
+	// create (the sequential generator is the stream 0 of the seed).
+	static philox slot_random(unsigned long seed, unsigned long iter, std::size_t slot) {
+		return philox(seed, std::uint32_t(iter), std::uint32_t(slot));
+	}
+
+	// Fitness comparison where nans are the worst
+	template<typename YType>
+	static bool better(YType a, YType b) { return (!std::isnan(a)) && (std::isnan(b) || (a < b)); }
+
+public:
+	DifferentialEvolution(unsigned long iters = 1000,
+		DEStrategy strategy           = DEStrategy::rand_1_bin,
+		float weight                  = 0.5f,
+		float crossover_rate          = 0.9f,
+		unsigned long seed = (std::random_device())(),
+		unsigned int nthreads         = 1,
+		float pbest                   = 0.05f,
+		float adaptation              = 0.1f,
+		const stopping& stop          = stopping()) :
+		iters_(iters),
+		strategy_(strategy),
+		weight_(weight),
+		crossover_rate_(crossover_rate),
+		seed_(seed),
+		nthreads_(nthreads),
+		pbest_(pbest),
+		adaptation_(adaptation),
+		stop_(stop) {}
+
+	/**
+	 * Minimizes the function f from the initial population ini (which sets the population size, at least 4)
+	 * until the best value is below the threshold or after the given number of iterations.
+	 * - XCollection is an iterable collection of XType, a random access container of numbers of the same size.
+	 * - FTarget is a function that, given a XType, returns an YType: YType F(XType), or a BatchTargetFunction
+	 *   that evaluates all the trial vectors of an iteration in a single call.
+	 * - Logger receives the population after each iteration (see ../genetic/logger.h).
+	 *
+	 * With nthreads > 1 the trial vectors are built and evaluated concurrently, so FTarget must be safe to call
+	 * from several threads at once. For a given seed, the result is the same for any number of threads other
+	 * than one (also 0 on a single core machine).
+	 **/
+	template<typename XCollection, typename FTarget, typename YType, typename Logger,
+			typename XType = typename XCollection::value_type>
+	requires std::is_floating_point_v<YType> &&
+	         Container<XCollection> &&
+	         RandomAccessContainer<XType> &&
+	         std::is_arithmetic_v<typename XType::value_type> &&
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>)
+	XType minimize(const XCollection& ini, const FTarget& f, const YType& threshold, Logger& logger) const {
+		using V = typename XType::value_type;
+		thread_pool pool(nthreads_);
+		philox random(seed_);
+		stopping::monitor monitor = stop_.start();
+
+		Population<XType,YType> population(ini.begin(), ini.end());
+		const std::size_t np = population.size();
+		if (np == 0) return XType();
+		evaluate<XType,YType>(f, population.genes(), population.fitness(), pool);
+		monitor.evaluated(np);
+		auto best_of = [&population, np] () {
+			std::size_t best = 0;
+			for (std::size_t i = 1; i < np; ++i) if (better(population.y(i), population.y(best))) best = i;
+			return best;
+		};
+		std::size_t best = best_of();
+		logger.log(0, population.begin(), population.end());
+		if (np < 4) return population.x(best); //Not enough individuals for the differences
+
+		//Trial vectors (written in place on the slots of the previous iteration) and, for JADE, the F and CR of
+		//each trial, the archive of replaced parents and the ranking for choosing the pbest individuals.
+		Population<XType,YType> trials(np, population.x(0));
+		std::vector<double> weight(np, weight_), rate(np, crossover_rate_);
+		std::vector<XType> archive; archive.reserve(np);
+		std::vector<std::size_t> ranking(np);
+		double mean_weight = weight_, mean_rate = crossover_rate_;
+		const bool adaptive = (strategy_ == DEStrategy::current_to_pbest_1_bin);
+		const std::size_t npbest = std::max<std::size_t>(1, std::size_t(std::round(double(pbest_)*double(np))));
+
+		for (unsigned long iter = 1; (iter <= iters_) && !(population.y(best) <= threshold) && !monitor.stop(); ++iter) {
+			if (adaptive) {
+				std::iota(ranking.begin(), ranking.end(), 0);
+				std::partial_sort(ranking.begin(), ranking.begin() + npbest, ranking.end(),
+					[&population] (std::size_t a, std::size_t b) { return better(population.y(a), population.y(b)); });
+			}
+
+			auto trial = [&] (std::size_t i, philox& random) {
+				std::uniform_int_distribution<std::size_t> index(0, np - 1);
+				std::uniform_real_distribution<double> uniform(0.0, 1.0);
+				double F = weight_, CR = crossover_rate_;
+				if (adaptive) {
+					std::cauchy_distribution<double> cauchy(mean_weight, 0.1);
+					do { F = cauchy(random); } while (F <= 0.0);
+					F = std::min(F, 1.0);
+					std::normal_distribution<double> normal(mean_rate, 0.1);
+					CR = std::clamp(normal(random), 0.0, 1.0);
+				}
+				weight[i] = F; rate[i] = CR;
+
+				//Distinct individuals, all different from i (r2 may come from the archive for JADE)
+				std::size_t r0, r1, r2;
+				do { r0 = index(random); } while (r0 == i);
+				do { r1 = index(random); } while ((r1 == i) || (r1 == r0));
+				std::uniform_int_distribution<std::size_t> index_archive(0, np + archive.size() - 1);
+				do { r2 = adaptive?index_archive(random):index(random); } while ((r2 == i) || (r2 == r0) || (r2 == r1));
+				const XType& x = population.x(i);
+				const XType& x2 = (r2 < np)?population.x(r2):archive[r2 - np];
+
+				XType& u = trials.x(i);
+				u = x;
+				std::uniform_int_distribution<std::size_t> gene(0, x.size() - 1);
+				std::size_t forced = gene(random);
+				const XType& pbest = population.x(adaptive?ranking[std::uniform_int_distribution<std::size_t>(0, npbest - 1)(random)]:best);
+				for (std::size_t j = 0; j < x.size(); ++j) {
+					if ((j != forced) && !(uniform(random) < CR)) continue;
+					switch (strategy_) {
+						case DEStrategy::rand_1_bin:
+							u[j] = V(population.x(r0)[j] + F*(double(population.x(r1)[j]) - double(x2[j]))); break;
+						case DEStrategy::best_1_bin:
+							u[j] = V(pbest[j] + F*(double(population.x(r0)[j]) - double(population.x(r1)[j]))); break;
+						case DEStrategy::current_to_pbest_1_bin:
+							u[j] = V(x[j] + F*(double(pbest[j]) - double(x[j])) + F*(double(population.x(r1)[j]) - double(x2[j]))); break;
+					}
+				}
+			};
+			if (nthreads_ != 1) pool.parallel_for(np, [&] (std::size_t i) {
+				philox random = slot_random(seed_, iter, i);
+				trial(i, random);
+			});
+			else for (std::size_t i = 0; i < np; ++i) trial(i, random);
+			evaluate<XType,YType>(f, trials.genes(), trials.fitness(), pool);
+
+			//Selection: each trial replaces its parent if it is not worse
+			double sum_rate = 0.0, sum_weight = 0.0, sum_weight2 = 0.0;
+			std::size_t successes = 0;
+			for (std::size_t i = 0; i < np; ++i) {
+				if (better(population.y(i), trials.y(i))) continue;
+				if (adaptive && better(trials.y(i), population.y(i))) {
+					if (archive.size() < np) archive.push_back(population.x(i));
+					else archive[std::uniform_int_distribution<std::size_t>(0, np - 1)(random)] = population.x(i);
+					++successes; sum_rate += rate[i]; sum_weight += weight[i]; sum_weight2 += weight[i]*weight[i];
+				}
+				std::swap(population.x(i), trials.x(i));
+				std::swap(population.y(i), trials.y(i));
+			}
+			if (adaptive && (successes > 0)) {
+				mean_rate = (1.0 - adaptation_)*mean_rate + adaptation_*(sum_rate/double(successes));
+				mean_weight = (1.0 - adaptation_)*mean_weight + adaptation_*(sum_weight2/sum_weight); //Lehmer mean
+			}
+			best = best_of();
+			monitor.evaluated(np);
+			monitor.iteration(population.begin(), population.end());
+			logger.log(iter, population.begin(), population.end());
+		}
+		return population.x(best);
+	}
+};
+
+DifferentialEvolution differential_evolution(unsigned long iterations = 1000, DEStrategy strategy = DEStrategy::rand_1_bin, float weight = 0.5f,
+		float crossover_rate = 0.9f, unsigned long seed = (std::random_device())(), unsigned int threads = 1, const stopping& stop = stopping()) {
+	return DifferentialEvolution(iterations, strategy, weight, crossover_rate, seed, threads, 0.05f, 0.1f, stop);
+}
+
+} // namespace opt
+
+#include "minimize.h"
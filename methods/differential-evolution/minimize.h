@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <callable/callable.hpp>
+#include "../../utils/concepts.h"
+#include "../genetic/minimize.h"
+#include "../genetic/logger.h"
+#include "concepts.h"
+
+namespace opt {
+
+/*************************************
+ * Default calls strategies *
+ *************************************/
+
+template<typename Method, typename F,
+	typename XType = typename std::decay_t<typename callable_traits<F>::template argument_type<0>>,
+	typename YType = decltype(std::declval<F>()(std::declval<XType>())),
+	typename InitialPopulation>
+requires DifferentialEvolutionMethod<Method> &&
+         TargetFunction<F,XType,YType> &&
+	 Container<InitialPopulation>
+XType minimize(const F& f, const Method& method, const InitialPopulation& initial_population) {
+	auto logger = genetic_logger::null();
+	return method.minimize(initial_population, f, YType(1.e-10), logger);
+}
+
+//Random initial population of 10 individuals per dimension (between 20 and 200)
+template<typename Method, typename F,
+	typename XType = typename std::remove_cv_t<typename std::remove_reference_t<typename callable_traits<F>::template argument_type<0>>>,
+	typename YType = decltype(std::declval<F>()(std::declval<XType>()))>
+requires DifferentialEvolutionMethod<Method> &&
+         TargetFunction<F,XType,YType>
+XType minimize(const F& f, const Method& method) {
+	std::mt19937 random;
+	auto init = init_default<XType>::strategy(random);
+	std::size_t size = std::clamp<std::size_t>(10*init().size(), 20, 200);
+	return minimize(f, method, initialization::population(size, init));
+}
+
+}; // namespace opt
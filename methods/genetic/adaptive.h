@@ -0,0 +1,185 @@
+#pragma once
+
+#include <random>
+#include <memory>
+#include <atomic>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include "concepts.h"
+#include "../../utils/concepts.h"
+#include "../../utils/genome-hash.h"
+
+namespace opt {
+
+/**
+ * Genome for self-adaptive mutations: a position together with the standard deviation used for mutating
+ * each of its genes, which evolve with it (see mutation::self_adaptive). It behaves as its position when
+ * indexed or iterated, so functions on random access containers can evaluate it directly.
+ **/
+template<typename C>
+requires RandomAccessContainer<C> && std::is_floating_point_v<typename C::value_type>
+class adaptive_genome {
+public:
+	using value_type = typename C::value_type;
+	using size_type  = typename C::size_type;
+
+	C x;		// the position
+	C sigma;	// step size of each gene
+
+	adaptive_genome() { }
+	adaptive_genome(const C& x, const C& sigma) : x(x), sigma(sigma) { }
+	adaptive_genome(const C& x, value_type s) : x(x), sigma(x) { std::fill(sigma.begin(), sigma.end(), s); }
+
+	size_type size() const { return x.size(); }
+	const value_type& operator[](size_type i) const { return x[i]; }
+	value_type& operator[](size_type i) { return x[i]; }
+	auto begin() const { return x.begin(); }
+	auto end() const { return x.end(); }
+	auto begin() { return x.begin(); }
+	auto end() { return x.end(); }
+	operator const C&() const { return x; }
+
+	bool operator==(const adaptive_genome& that) const { return (x == that.x) && (sigma == that.sigma); }
+
+	friend std::ostream& operator<<(std::ostream& os, const adaptive_genome& g) {
+		os<<"[";
+		for (size_type i = 0; i < g.size(); ++i) os<<(i?" ":"")<<g.x[i];
+		return os<<"]";
+	}
+};
+
+namespace mutation {
+
+/**
+ * Normal mutation of a real number whose standard deviation follows the 1/5th success rule: after each
+ * generation the engine reports how many of its mutations improved their parent (see adapt), and the
+ * standard deviation grows if more than a fifth of them did (the steps are too conservative) or shrinks
+ * otherwise (the steps overshoot). Copies share the standard deviation, so the engine adapts the operator
+ * that the caller keeps (and the islands of GeneticIslands adapt a common one). It is safe to mutate and adapt
+ * from several threads.
+ *
+ * Reference: I. Rechenberg, Evolutionsstrategie (1973); the smooth update is from S. Kern et al., Learning
+ * probability distributions in continuous evolutionary algorithms (2004).
+ **/
+template <typename R>
+requires std::is_floating_point_v<R>
+class real_normal_adaptive {
+	std::shared_ptr<std::atomic<R>> stddev_;
+	R target, damping, min_stddev, max_stddev;
+public:
+	real_normal_adaptive(R stddev, R target = R(0.2), R damping = R(1),
+	                     R min_stddev = std::numeric_limits<R>::min(), R max_stddev = std::numeric_limits<R>::max()) :
+		stddev_(std::make_shared<std::atomic<R>>(stddev)), target(target), damping(damping), min_stddev(min_stddev), max_stddev(max_stddev) { }
+
+	template<typename RNG>
+	requires UniformRandomBitGenerator<RNG>
+	R operator()(const R& c, RNG& random) const {
+		std::normal_distribution<R> sample(c, stddev_->load(std::memory_order_relaxed));
+	       	return sample(random);
+	}
+
+	void adapt(unsigned long successes, unsigned long trials) const {
+		if (trials == 0) return;
+		R factor = std::exp((R(successes)/R(trials) - target)/(damping*(R(1) - target)));
+		R current = stddev_->load();
+		while (!stddev_->compare_exchange_weak(current, std::clamp(current*factor, min_stddev, max_stddev))) { }
+	}
+
+	R stddev() const { return stddev_->load(); }
+};
+
+/**
+ * Log-normal self-adaptation for adaptive_genome: first the step size of each gene is mutated,
+ * sigma_i' = sigma_i * exp(tau' N(0,1) + tau N_i(0,1)), with a global factor shared by all the genes, and
+ * then each gene with its new step size, x_i' = x_i + sigma_i' N_i(0,1). Selection keeps the step sizes
+ * that produce good offspring, so there is no feedback from the engine. The learning rates default to
+ * tau' = 1/sqrt(2n) and tau = 1/sqrt(2 sqrt(n)) for n genes.
+ *
+ * Reference: H.-G. Beyer and H.-P. Schwefel, Evolution strategies - A comprehensive introduction (2002)
+ **/
+template <typename R = float>
+requires std::is_floating_point_v<R>
+class self_adaptive {
+	R min_sigma, tau_global, tau_local;
+public:
+	self_adaptive(R min_sigma = R(1.e-10), R tau_global = R(0), R tau_local = R(0)) :
+		min_sigma(min_sigma), tau_global(tau_global), tau_local(tau_local) { }
+
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG>
+	adaptive_genome<C> operator()(const adaptive_genome<C>& g, RNG& random) const {
+		adaptive_genome<C> sol = g;
+		(*this)(g, sol, random);
+		return sol;
+	}
+
+	//In place version: writes the mutation of g into sol, reusing its storage
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG>
+	void operator()(const adaptive_genome<C>& g, adaptive_genome<C>& sol, RNG& random) const {
+		using V = typename C::value_type;
+		if (&sol != &g) sol = g;
+		R n = R(g.size());
+		R global = (tau_global > R(0))?tau_global:(R(1)/std::sqrt(R(2)*n));
+		R local  = (tau_local > R(0))?tau_local:(R(1)/std::sqrt(R(2)*std::sqrt(n)));
+		std::normal_distribution<R> normal;
+		R common = global*normal(random);
+		for (typename C::size_type i = 0; i < g.size(); ++i) {
+			sol.sigma[i] = V(std::max(min_sigma, R(g.sigma[i])*std::exp(common + local*normal(random))));
+			sol.x[i] = V(R(g.x[i]) + R(sol.sigma[i])*normal(random));
+		}
+	}
+};
+
+} //namespace mutation
+
+namespace crossover {
+
+/**
+ * Crossover of adaptive_genome: the positions are crossed with the given operator and the step sizes are
+ * averaged (intermediate recombination, which smooths the self-adaptation).
+ **/
+template<typename FCrossover>
+class self_adaptive {
+	FCrossover cross;
+public:
+	self_adaptive(const FCrossover& cross) : cross(cross) { }
+
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG> && CrossoverFunction<FCrossover, C, RNG>
+	adaptive_genome<C> operator()(const adaptive_genome<C>& g1, const adaptive_genome<C>& g2, RNG& random) const {
+		adaptive_genome<C> sol(cross(g1.x, g2.x, random), g1.sigma);
+		for (typename C::size_type i = 0; i < sol.size(); ++i) sol.sigma[i] = (g1.sigma[i] + g2.sigma[i])/2;
+		return sol;
+	}
+};
+
+} //namespace crossover
+
+namespace initialization {
+
+/**
+ * Initialization of adaptive_genome: the positions from the given initialization and the same step size for all genes
+ **/
+template<typename F, typename R>
+requires std::is_floating_point_v<R>
+auto self_adaptive(const F& f, R sigma) {
+	return [f, sigma] () {
+		auto x = f();
+		return adaptive_genome<decltype(x)>(x, typename decltype(x)::value_type(sigma));
+	};
+}
+
+} //namespace initialization
+
+} // namespace opt
+
+//Hash of the position, so that adaptive_genome can be used with GeneticBest (which keeps a hash table of the population)
+namespace std {
+	template<typename C>
+	struct hash<opt::adaptive_genome<C>> {
+		std::size_t operator()(const opt::adaptive_genome<C>& g) const { return opt::genome_hash<C>()(g.x); }
+	};
+}
@@ -4,37 +4,71 @@
 #include <iostream>
 #include <functional>
 #include "../../utils/concepts.h"
+#include "../../utils/span.h"
+#include "../../utils/philox.h"
 #include "bitwise.h"
+#include "logger.h"
 
 namespace opt {
 
-template <typename FMutation, typename XType, typename RNG = std::mt19937>
+template <typename FMutation, typename XType, typename RNG = philox>
 concept bool MutationFunction = 
    UniformRandomBitGenerator<RNG> &&
    requires(FMutation f, const XType& a, XType b, RNG& rng) {
 	b = f(a, rng);
    };
 
-template <typename FCrossover, typename XType, typename RNG = std::mt19937>
+template <typename FCrossover, typename XType, typename RNG = philox>
 concept bool CrossoverFunction = 
    UniformRandomBitGenerator<RNG> &&
    requires(FCrossover f, const XType& a1, const XType& a2, XType b, RNG& rng) {
 	b = f(a1, a2, rng);
    };
 
+//Mutation that writes its result on an existing XType (b), so that its storage can be reused
+template <typename FMutation, typename XType, typename RNG = philox>
+concept bool InPlaceMutationFunction = 
+   UniformRandomBitGenerator<RNG> &&
+   requires(FMutation f, const XType& a, XType& b, RNG& rng) {
+	f(a, b, rng);
+   };
+
+//Mutation whose strength depends on how many of its previous mutations improved their parents (see adaptive.h).
+//Engines call adapt after evaluating the mutations of each generation.
+template <typename FMutation>
+concept bool AdaptiveMutationFunction = 
+   requires(const FMutation& f, unsigned long successes, unsigned long trials) {
+	f.adapt(successes, trials);
+   };
+
+//Crossover that writes its result on an existing XType (b), so that its storage can be reused
+template <typename FCrossover, typename XType, typename RNG = philox>
+concept bool InPlaceCrossoverFunction = 
+   UniformRandomBitGenerator<RNG> &&
+   requires(FCrossover f, const XType& a1, const XType& a2, XType& b, RNG& rng) {
+	f(a1, a2, b, rng);
+   };
+
 template<typename FTarget, typename XType, typename YType>
 concept bool TargetFunction =
    requires(FTarget f, const XType& x, YType y) {
 	y = f(x);
    };
 
-template<typename O, typename RNG = std::mt19937>
+//Evaluates a whole set of individuals at once: y[i] = f(x[i]) for every i
+template<typename FTarget, typename XType, typename YType>
+concept bool BatchTargetFunction =
+   requires(FTarget f, span<const XType> x, span<YType> y) {
+	f(x, y);
+   };
+
+template<typename O, typename RNG = philox>
 concept bool MutableObject =
    requires(O a, O b, RNG& random) { 
        b = a.mutate(random);
    };
 
-template<typename O, typename RNG = std::mt19937>
+template<typename O, typename RNG = philox>
 concept bool CrossableObject =
    requires(O a, O b, O c, RNG& random) { 
        c = a.cross(b, random);
@@ -43,7 +77,7 @@ concept bool CrossableObject =
 
 template<typename Method>
 concept bool GeneticMethod =
-    requires(const Method& m, std::function<float(float)> target, const std::array<float,1>& init, float sol) {
-	sol = m.minimize(init, target, mutation::bit32_swap(), crossover::bit32_onepoint(), 0.0f, std::cout); 
+    requires(const Method& m, std::function<float(float)> target, const std::array<float,1>& init, genetic_logger::null& logger, float sol) {
+	sol = m.minimize(init, target, mutation::bit32_swap(), crossover::bit32_onepoint(), 0.0f, logger); 
     };
 } // namespace opt
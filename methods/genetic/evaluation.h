@@ -0,0 +1,42 @@
+#pragma once
+
+#include "concepts.h"
+#include "../../utils/span.h"
+#include "../../utils/thread-pool.h"
+
+namespace opt {
+
+/**
+ * Evaluates the fitness of a set of individuals: y[i] = f(x[i]). A BatchTargetFunction gets the whole
+ * set in a single call; otherwise f is called once per individual, spread over the threads of the pool
+ * if one is given.
+ **/
+template<typename XType, typename YType, typename FTarget>
+requires TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>
+void evaluate(const FTarget& f, span<const XType> x, span<YType> y, thread_pool& pool) {
+	if constexpr (BatchTargetFunction<FTarget, XType, YType>) f(x, y);
+	else pool.parallel_for(x.size(), [&] (std::size_t i) { y[i] = f(x[i]); });
+}
+
+template<typename XType, typename YType, typename FTarget>
+requires TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>
+void evaluate(const FTarget& f, span<const XType> x, span<YType> y) {
+	if constexpr (BatchTargetFunction<FTarget, XType, YType>) f(x, y);
+	else for (std::size_t i = 0; i < x.size(); ++i) y[i] = f(x[i]);
+}
+
+/**
+ * Single individual evaluation, also for objectives that only provide the batch interface.
+ **/
+template<typename XType, typename YType, typename FTarget>
+requires TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>
+YType evaluate(const FTarget& f, const XType& x) {
+	if constexpr (BatchTargetFunction<FTarget, XType, YType>) {
+		YType y; 
+		f(span<const XType>(&x, 1), span<YType>(&y, 1));
+		return y;
+	}
+	else return f(x);
+}
+
+} // namespace opt
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "concepts.h"
-#include <iostream>
-#include <iomanip>
+#include "evaluation.h"
+#include "offspring.h"
+#include "../../utils/stopping.h"
+#include "../../utils/profile.h"
+#include "../../utils/checkpoint.h"
+#include "logger.h"
 #include <type_traits>
 #include <vector>
 #include <random>
 #include <set>
-#include <unordered_set>
+#include <unordered_map>
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 namespace opt {
 
@@ -26,7 +31,16 @@ private:
 	unsigned int   best_for_crossover_;	// number of the best elements of the population to crossover
 	unsigned int   ncrossovers_;		// number of crossovers per iteration
 	unsigned long  seed_;			// The seed for the random number generator (random by default)
-
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h)
+	checkpoint     checkpoint_;		// periodic saving of the state, and resuming from it (see ../../utils/checkpoint.h)
+
+	//Order of the genomes that breaks ties of fitness: their operator < if they have one, and otherwise their bytes
+	template<typename XType>
+	static bool genome_before(const XType& a, const XType& b) {
+		if constexpr (LessThanComparable<XType>) return a < b;
+		else if constexpr (std::is_trivially_copyable_v<XType>) return std::memcmp(&a, &b, sizeof(XType)) < 0;
+		else return false;
+	}
 
 public:
 	GeneticBest(unsigned int iters 	        = 1000,
@@ -34,15 +48,19 @@ public:
 		unsigned int nmutations         =   10,
 		unsigned int best_for_crossover =   10,
 		unsigned int ncrossovers        =   10,
-		unsigned long seed = (std::random_device())()) :
+		unsigned long seed = (std::random_device())(),
+		const stopping& stop            = stopping(),
+		const checkpoint& checkpoints   = checkpoint()) :
 		iters_(iters), 
 		best_for_mutation_(best_for_mutation), nmutations_(nmutations),
 		best_for_crossover_(best_for_crossover), ncrossovers_(ncrossovers),
-		seed_(seed) 
+		seed_(seed),
+		stop_(stop),
+		checkpoint_(checkpoints)
 	{}
 			
 	/**
-	 * Minimizes the function f, giving an initial population ini, and logs the process in the output stream os. The
+	 * Minimizes the function f, giving an initial population ini, and logs the process with the logger. The
 	 * threshold defines a value below which we consider the outcome good enough
 	 *
 	 * - XCollection is an iterable collection of XType, which is the initial population. It must have at least 
@@ -50,92 +68,158 @@ public:
 	 * - XType has support for mutations and crossovers, by the functions FMutation and FCrossover 
 	 * - RNG is a C++11-like random number engine
 	 * - FTarget is a function that, given a XType, returns an YValue: YValue F(XType). 
-	 *   	This is the function to minimize.
+	 *   	This is the function to minimize. It can also be a BatchTargetFunction. Each individual is evaluated
+	 *   	once (so at most nmutations + ncrossovers evaluations per iteration).
 	 * - YType is comparable (has support for the binary < operator, returning bool) and can be checked for nans.
-	 * - OS is an output stream (support for standard binary << and for binary << with XType)
+	 * - Logger receives the population (the best for crossover and their offspring) after each iteration, as
+	 *   (XType, YType) pairs in no particular order (see logger.h)
+	 *
+	 * With a checkpoint, the state is saved every given number of iterations and, if there is a checkpoint
+	 * file of a run with the same parameters and ini, the method continues from it instead of from ini (which
+	 * is then not evaluated), and the file is removed when the method finishes. The best individuals are sorted
+	 * (by fitness and then by genome) before choosing the parents, so a resumed run gets the same result as an
+	 * uninterrupted one, although the order of the hash table of the population is not restored.
 	 **/
-	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename OS, 
+	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger, 
 			typename XType = typename XCollection::value_type>
 	requires Container<XCollection> &&
-	         TargetFunction<FTarget, XType, YType> &&
-	         MutationFunction<FMutation, XType, std::mt19937> &&
-	         CrossoverFunction<FCrossover, XType, std::mt19937>
-	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, OS& os) const {
-		std::mt19937 random(seed_);
-
-		auto cmp = [&f] (const XType& x1, const XType& x2) { YType fx1 = f(x1); YType fx2 = f(x2); return std::isnan(fx1)?false:(std::isnan(fx2)?true:(f(x1) < f(x2))); };
-
-		std::unordered_set<XType> population; 		
-		for (const XType& x: ini) {
-			population.insert(x);
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, Logger& logger) const {
+		philox random(seed_);
+		stopping::monitor monitor = stop_.start();
+		checkpoint_.check<XType>();
+		const std::string run_id = checkpoint_.identify(ini.begin(), ini.end(), seed_, iters_, best_for_mutation_, nmutations_, best_for_crossover_, ncrossovers_);
+		checkpoint::reader resumed = checkpoint_.load("GeneticBest", run_id);
+
+		//Individuals are compared through their stored fitness (nans are the worst) and then through their genome,
+		//so that which ones are the best, and their order, does not depend on the order of the hash table
+		auto cmp = [] (const auto& x1, const auto& x2) {
+			YType fx1 = x1.second; YType fx2 = x2.second;
+			if (std::isnan(fx1) || std::isnan(fx2)) return std::isnan(fx1)?(std::isnan(fx2) && genome_before(x1.first, x2.first)):true;
+			return (fx1 < fx2) || ((fx1 == fx2) && genome_before(x1.first, x2.first));
 		};
 
-		std::vector<XType> vbest;    vbest.reserve(std::max(best_for_mutation_, best_for_crossover_)+1);
-		XType best = *(population.begin());
-
-		decltype(population.begin()) itpop;
-
-		for (unsigned long iter = 0; (iter<iters_) && (f(best) > threshold);++iter) {
-			//Mutation stage
-			vbest.clear();
-			for (itpop = population.begin(); (itpop != population.end()); ++itpop) 
+		//The population keeps the fitness of each individual, so each of them is evaluated only once
+		std::unordered_map<XType, YType> population; 		
+		std::vector<XType> offspring(ini.begin(), ini.end());
+		std::vector<YType> fitness;
+		//Fitness of the parent of each mutation and of the individuals they are chosen from (for adaptive
+		//mutations), and the scratch to find the median of the latter. The parents are kept along the offspring.
+		std::vector<YType> parents, selected, sorted;
+		sorted.reserve(best_for_mutation_);
+		profiler<ProfilingLogger<Logger>> profiler;
+		//New individuals are evaluated all at once and added to the population (unless they were already there)
+		auto add_offspring = [&] () {
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < offspring.size(); ++i) {
+				if (population.count(offspring[i]) > 0) continue;
+				if (kept != i) {
+					offspring[kept] = std::move(offspring[i]);
+					if (!parents.empty()) parents[kept] = parents[i];
+				}
+				++kept;
+			}
+			offspring.erase(offspring.begin() + kept, offspring.end());
+			if (!parents.empty()) parents.resize(kept);
+			fitness.resize(offspring.size());
 			{
-				vbest.push_back(*itpop);
+				auto timing = profiler.stage(&generation_profile::evaluation);
+				evaluate<XType,YType>(f, offspring, fitness);
+			}
+			monitor.evaluated(offspring.size());
+			profiler.evaluated(offspring.size());
+			for (std::size_t i = 0; i < offspring.size(); ++i) population.emplace(offspring[i], fitness[i]);
+			offspring.clear();
+		};
+		unsigned long first = 0;
+		if (resumed) {
+			offspring.clear();
+			stopping::monitor::state state; std::uint64_t size;
+			resumed>>first>>random>>state>>size;
+			std::pair<XType, YType> individual = std::make_pair(*ini.begin(), YType());
+			for (std::uint64_t i = 0; i < size; ++i) { resumed>>individual.first>>individual.second; population.insert(individual); }
+			monitor.restore(state);
+		} else add_offspring();
+
+		std::vector<std::pair<XType, YType>> vbest;    vbest.reserve(std::max(best_for_mutation_, best_for_crossover_)+1);
+		auto select_best = [&] (unsigned int nbest) {
+			vbest.clear();
+			for (const auto& individual : population) {
+				vbest.push_back(individual);
 				std::push_heap(vbest.begin(), vbest.end(), cmp);
-				if (vbest.size() > best_for_mutation_) {
+				if (vbest.size() > nbest) {
 					std::pop_heap(vbest.begin(), vbest.end(), cmp);
 					vbest.pop_back();
 				}
 			}
+			std::sort(vbest.begin(), vbest.end(), cmp);
+		};
+		std::pair<XType, YType> best = *std::min_element(population.begin(), population.end(), cmp);
+		logger.log(first, population.begin(), population.end());
+
+		for (unsigned long iter = first; (iter<iters_) && (best.second > threshold) && !monitor.stop();++iter) {
+			profiler.begin(iter + 1);
+			//Mutation stage
+			{
+				auto timing = profiler.stage(&generation_profile::selection);
+				select_best(best_for_mutation_);
+				population.clear();
+				for (const auto& b : vbest) population.insert(b);
+			}
 			
-			os <<"["<<iter<<"] Best for mutation : ";
-			for (const XType& b :  vbest) os << b << "   ";
-			os<<std::endl;
-			population.clear();
-			
-			for (unsigned int m = 0; m<nmutations_; ++m) {
-				std::uniform_int_distribution<int> sample_mutation(0, vbest.size()-1);
-				int chosen = sample_mutation(random);
-				XType mutation = mutate(vbest[chosen], random);
-//				os<<"Mutating: "<<vbest[chosen]<<" -> "<<mutation<<std::endl;
-				population.insert(mutation);
+			selected.clear();
+			for (const auto& b : vbest) selected.push_back(b.second);
+			{
+				auto timing = profiler.stage(&generation_profile::mutation);
+				for (unsigned int m = 0; m<nmutations_; ++m) {
+					std::uniform_int_distribution<int> sample_mutation(0, vbest.size()-1);
+					int chosen = sample_mutation(random);
+					offspring.push_back(mutate(vbest[chosen].first, random));
+					parents.push_back(vbest[chosen].second);
+				}
 			}
-
-			for (const XType& x : vbest) population.insert(x);
+			add_offspring();
+			//Mutations that were already in the population count as failures
+			adapt_mutation(mutate, span<const YType>(selected), span<const YType>(parents), span<const YType>(fitness), nmutations_, sorted);
+			parents.clear();
 
 			//Crossover stage
-			vbest.clear();
-			for (itpop = population.begin(); (itpop != population.end()); ++itpop) 
 			{
-				vbest.push_back(*itpop);
-				std::push_heap(vbest.begin(), vbest.end(), cmp);
-				if (vbest.size() > best_for_crossover_) {
-					std::pop_heap(vbest.begin(), vbest.end(), cmp);
-					vbest.pop_back();
-				}
+				auto timing = profiler.stage(&generation_profile::selection);
+				select_best(best_for_crossover_);
+				population.clear();
+				for (const auto& b : vbest) population.insert(b);
 			}
-
-			os <<"["<<iter<<"] Best for crossover: ";
-			for (const XType& b :  vbest) os << b << "   ";
-			os<<std::endl;
-			population.clear();
 			
-			for (unsigned int c = 0; c<ncrossovers_; ++c) {
-				std::uniform_int_distribution<int> sample_crossover(0, vbest.size()-1);
-				int chosen1 = sample_crossover(random);
-				int chosen2 = sample_crossover(random);
-				if (chosen1 != chosen2) {
-					population.insert(cross(vbest[chosen1],vbest[chosen2],random));
-				};
+			{
+				auto timing = profiler.stage(&generation_profile::crossover);
+				for (unsigned int c = 0; c<ncrossovers_; ++c) {
+					std::uniform_int_distribution<int> sample_crossover(0, vbest.size()-1);
+					int chosen1 = sample_crossover(random);
+					int chosen2 = sample_crossover(random);
+					if (chosen1 != chosen2) {
+						offspring.push_back(cross(vbest[chosen1].first,vbest[chosen2].first,random));
+					};
+				}
 			}
-
-			for (const XType& x : vbest) population.insert(x);
-
+			add_offspring();
 
 			best = (*std::min_element(population.begin(), population.end(), cmp));
+			monitor.iteration(population.begin(), population.end());
+			profiler.end(logger, population.begin(), population.end());
+			logger.log(iter + 1, population.begin(), population.end());
+			if (checkpoint_.due(iter + 1)) {
+				checkpoint::writer writer = checkpoint_.save("GeneticBest", run_id);
+				writer<<(iter + 1)<<random<<monitor.saved()<<std::uint64_t(population.size());
+				for (const auto& individual : population) writer<<individual.first<<individual.second;
+				writer.commit();
+			}
 		}
 
-		return best;
+		checkpoint_.finish();
+		return best.first;
 	}
 };
 
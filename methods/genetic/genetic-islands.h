@@ -0,0 +1,151 @@
+#pragma once
+
+#include "concepts.h"
+#include "evaluation.h"
+#include "population.h"
+#include "logger.h"
+#include "genetic-stochastic-best.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Island model: evolves several populations (islands) independently, each one on its own thread and with
+ * its own engine (a copy of the given one, by default GeneticStochasticBest), and every migration_interval
+ * iterations the best nmigrants individuals of each island replace the worst ones of the next island (in a ring).
+ *
+ * The Engine must provide:
+ * - Population<XType,YType> evolve(initial_population, f, mutate, cross, threshold, logger, iterations, seed, monitor, selected),
+ *   which returns the selected population of the last iteration (as GeneticStochasticBest::evolve), reporting
+ *   its evaluations to the stopping::monitor and stopping when it says so. Except in the first epoch, the islands
+ *   are already selected populations, so selected is true.
+ * - unsigned long iterations(), the total number of iterations of each island.
+ **/
+template<typename Engine = GeneticStochasticBest>
+class GeneticIslands
+{
+private:
+	Engine         engine_;			// engine that evolves each island
+	unsigned int   nislands_;		// number of islands
+	unsigned long  migration_interval_; // number of iterations between migrations
+	unsigned int   nmigrants_;		// number of individuals that each island sends to the next one
+	unsigned int   nthreads_;		// number of threads (0 = as many as the hardware supports)
+	unsigned long  seed_;			// The seed for the islands (random by default)
+	stopping       stop_;			// additional stopping criteria, checked at each migration
+
+	// Seed of each island at each epoch (the iterations between two migrations)
+	unsigned long island_seed(unsigned int island, unsigned long epoch) const {
+		philox random(seed_, std::uint32_t(epoch), island);
+		return (std::uint64_t(random()) << 32) | random();
+	}
+
+	//Indices of the population sorted from best to worst (NaNs last)
+	template<typename XType, typename YType>
+	static std::vector<std::size_t> ranking(const Population<XType,YType>& population) {
+		std::vector<std::size_t> order(population.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::stable_sort(order.begin(), order.end(), [&population] (std::size_t a, std::size_t b) {
+			return std::isfinite(population.y(a)) && (!std::isfinite(population.y(b)) || (population.y(a) < population.y(b))); });
+		return order;
+	}
+
+	template<typename XType, typename YType>
+	void migration(std::vector<Population<XType,YType>>& islands) const {
+		if (islands.size() < 2) return;
+		//Migrants are chosen before any island changes, so the order of the islands does not matter
+		std::vector<Population<XType,YType>> migrants;
+		for (const auto& island : islands) {
+			std::vector<std::size_t> order = ranking(island);
+			std::size_t n = std::min<std::size_t>(nmigrants_, island.size());
+			migrants.emplace_back(n, island.x(0));
+			for (std::size_t i = 0; i < n; ++i) migrants.back().assign(i, island, order[i]);
+		}
+		for (std::size_t k = 0; k < islands.size(); ++k) {
+			Population<XType,YType>& target = islands[(k + 1) % islands.size()];
+			std::vector<std::size_t> order = ranking(target);
+			for (std::size_t i = 0; (i < migrants[k].size()) && (i < target.size()); ++i)
+				target.assign(order[target.size() - 1 - i], migrants[k], i);
+		}
+	}
+
+public:
+	GeneticIslands(const Engine& engine = Engine(),
+		unsigned int nislands           =    4,
+		unsigned long migration_interval =  100,
+		unsigned int nmigrants          =    2,
+		unsigned int nthreads           =    0,
+		unsigned long seed = (std::random_device())(),
+		const stopping& stop            = stopping()) :
+		engine_(engine),
+		nislands_(std::max(1u, nislands)),
+		migration_interval_(std::max(1ul, migration_interval)),
+		nmigrants_(nmigrants),
+		nthreads_(nthreads),
+		seed_(seed),
+		stop_(stop)
+	{}
+
+	/**
+	 * Minimizes the function f from the initial population ini, with the same requirements as the minimize method of
+	 * the engine. Every island starts from the whole initial population. The islands run concurrently, so FTarget,
+	 * FMutation and FCrossover must be safe to call from several threads at once. The logger receives, after each
+	 * migration, the best individual of each island. The result for a given seed does not depend on the number of threads.
+	 * The time and evaluation budgets of the additional stopping criteria are checked by each island at every
+	 * iteration, counting the evaluations of all the islands. Stagnation and diversity are checked at each migration:
+	 * stagnation counts iterations without improving the best individual of all the islands, and diversity is
+	 * measured on the best individuals of the islands (so it detects that all of them converged to the same point).
+	 **/
+	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger,
+			typename XType = typename XCollection::value_type>
+	requires std::is_floating_point_v<YType> &&
+	         Container<XCollection> &&
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, Logger& logger) const {
+		thread_pool pool(nthreads_);
+		std::atomic<unsigned long> evaluations(0);
+		stopping::monitor monitor = stop_.start(evaluations);
+		std::vector<stopping::monitor> budgets(nislands_, stop_.budgets().start(evaluations));
+
+		Population<XType,YType> initial_population(ini.begin(), ini.end());
+		evaluate<XType,YType>(f, initial_population.genes(), initial_population.fitness(), pool);
+		monitor.evaluated(initial_population.size());
+		std::vector<Population<XType,YType>> islands(nislands_, initial_population);
+		Population<XType,YType> leaders(nislands_, initial_population.x(0));
+
+		unsigned long iters = engine_.iterations();
+		YType best = initial_population.y(ranking(initial_population)[0]);
+		for (unsigned long iter = 0, epoch = 0; (iter < iters) && (best > threshold) && !monitor.stop(); iter += migration_interval_, ++epoch) {
+			unsigned long n = std::min(migration_interval_, iters - iter);
+			pool.parallel_for(nislands_, [&] (std::size_t k) {
+				auto null = genetic_logger::null();
+				islands[k] = engine_.evolve(islands[k], f, mutate, cross, threshold, null, n, island_seed(k, epoch), budgets[k], epoch > 0);
+			});
+			migration(islands);
+
+			for (std::size_t k = 0; k < islands.size(); ++k) leaders.assign(k, islands[k], ranking(islands[k])[0]);
+			best = leaders.y(ranking(leaders)[0]);
+			monitor.iteration(leaders.begin(), leaders.end(), n);
+			logger.log(iter + n, leaders.begin(), leaders.end());
+		}
+
+		for (std::size_t k = 0; k < islands.size(); ++k) leaders.assign(k, islands[k], ranking(islands[k])[0]);
+		return leaders.x(ranking(leaders)[0]);
+	}
+};
+
+template<typename Engine>
+GeneticIslands<Engine> islands(const Engine& engine, unsigned int nislands = 4, unsigned long migration_interval = 100, unsigned int nmigrants = 2,
+                               unsigned int threads = 0, unsigned long seed = (std::random_device())(), const stopping& stop = stopping()) {
+	return GeneticIslands<Engine>(engine, nislands, migration_interval, nmigrants, threads, seed, stop);
+}
+
+} // namespace opt
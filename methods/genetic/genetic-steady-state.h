@@ -0,0 +1,193 @@
+#pragma once
+
+#include "concepts.h"
+#include "evaluation.h"
+#include "population.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include <type_traits>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Asynchronous steady-state genetic algorithm: instead of evolving the population one generation at a time, each
+ * thread repeatedly picks its parents by tournament, produces a single offspring (a crossover or a mutation),
+ * evaluates it and inserts it in the population, replacing the worst individual if it is better. There is
+ * no barrier between the threads, so they are always busy even if the evaluation time of the function varies a lot
+ * (with generations, all the threads wait for the slowest evaluation of each one).
+ *
+ * Each individual of the population has its own lock, held only while it is copied or replaced, and the values
+ * of the population can be read without locking, so threads barely wait for each other. The best individual is
+ * never replaced (only the worst ones, by better ones).
+ *
+ * With more than one thread the result depends on the timing of the threads, so it is not reproducible.
+ **/
+class GeneticSteadyState
+{
+private:
+	unsigned long  evaluations_;		// number of offspring (evaluations of the function)
+	unsigned int   npopulation_;		// population size
+	float          crossover_rate_;		// probability of an offspring being a crossover (a mutation otherwise)
+	unsigned int   tournament_;			// number of individuals that compete for being a parent
+	unsigned long  seed_;			// The seed for the random number generator (random by default)
+	unsigned int   nthreads_;		// number of threads (0 = as many as the hardware supports)
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h)
+
+	// Fitness comparison where nans are the worst
+	template<typename YType>
+	static bool better(YType a, YType b) { return (!std::isnan(a)) && (std::isnan(b) || (a < b)); }
+	template<typename YType>
+	static bool same(YType a, YType b) { return (a == b) || (std::isnan(a) && std::isnan(b)); }
+
+public:
+	GeneticSteadyState(unsigned long evaluations = 10000,
+		unsigned int npopulation        =   20,
+		float crossover_rate            = 0.5f,
+		unsigned int tournament         =    2,
+		unsigned long seed = (std::random_device())(),
+		unsigned int nthreads           =    0,
+		const stopping& stop            = stopping()) :
+		evaluations_(evaluations),
+		npopulation_(std::max(1u, npopulation)),
+		crossover_rate_(crossover_rate),
+		tournament_(std::max(1u, tournament)),
+		seed_(seed),
+		nthreads_(nthreads),
+		stop_(stop)
+	{}
+
+	/**
+	 * Minimizes the function f, giving an initial population ini (the best npopulation individuals of which start
+	 * the population) until an offspring is below the threshold or after the given number of offspring.
+	 * The requirements are the same as for GeneticStochasticBest, but FTarget, FMutation and FCrossover are called
+	 * concurrently from several threads. Each offspring is evaluated on its own, so a BatchTargetFunction gets
+	 * batches of one individual.
+	 *
+	 * The logger receives the population every npopulation offspring (as if it were a generation), and the
+	 * additional stopping criteria and adaptive mutations are updated at the same time.
+	 **/
+	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger,
+			typename XType = typename XCollection::value_type>
+	requires std::is_floating_point_v<YType> &&
+	         Container<XCollection> &&
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, Logger& logger) const {
+		thread_pool pool(nthreads_);
+		stopping::monitor monitor = stop_.start();
+
+		Population<XType,YType> initial_population(ini.begin(), ini.end());
+		evaluate<XType,YType>(f, initial_population.genes(), initial_population.fitness(), pool);
+		monitor.evaluated(initial_population.size());
+
+		//The best individuals of the initial population (repeated if there are not enough)
+		std::vector<std::size_t> order(initial_population.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::stable_sort(order.begin(), order.end(), [&initial_population] (std::size_t a, std::size_t b) {
+			return better(initial_population.y(a), initial_population.y(b)); });
+		const std::size_t n = npopulation_;
+		Population<XType,YType> population(n, initial_population.x(0));
+		std::vector<std::atomic<YType>> fitness(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			population.assign(i, initial_population, order[i % order.size()]);
+			fitness[i] = population.y(i);
+		}
+		std::vector<std::mutex> locks(n);
+
+		//Logging, stopping criteria and adaptation happen every n offspring, one thread at a time
+		std::mutex log_mutex;
+		Population<XType,YType> snapshot(n, initial_population.x(0));
+		unsigned long generation = 0;
+		std::atomic<unsigned long> next(0), successes(0), trials(0);
+		std::atomic<bool> done((population.y(0) <= threshold) || monitor.stop());
+		logger.log(0, population.begin(), population.end());
+
+		pool.parallel_for(pool.size(), [&] (std::size_t t) {
+			philox random(seed_, std::uint32_t(t));
+			std::uniform_int_distribution<std::size_t> index(0, n - 1);
+			std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+			auto tournament = [&] () {
+				std::size_t chosen = index(random);
+				for (unsigned int k = 1; k < tournament_; ++k) {
+					std::size_t other = index(random);
+					if (better(fitness[other].load(), fitness[chosen].load())) chosen = other;
+				}
+				return chosen;
+			};
+			XType parent1 = initial_population.x(0), parent2 = initial_population.x(0), child = initial_population.x(0);
+
+			for (unsigned long k = next++; (k < evaluations_) && !done; k = next++) {
+				std::size_t p1 = tournament();
+				YType parent_fitness;
+				{
+					std::lock_guard<std::mutex> lock(locks[p1]);
+					parent1 = population.x(p1); parent_fitness = population.y(p1);
+				}
+				bool crossing = uniform(random) < crossover_rate_;
+				if (crossing) {
+					std::size_t p2 = tournament();
+					{
+						std::lock_guard<std::mutex> lock(locks[p2]);
+						parent2 = population.x(p2);
+					}
+					child = cross(parent1, parent2, random);
+				} else child = mutate(parent1, random);
+				YType y = evaluate<XType,YType>(f, child);
+
+				//Replacement of the worst individual (looked for again if another thread replaced it meanwhile)
+				bool inserted = false;
+				for (unsigned int attempt = 0; (attempt < 3) && !inserted; ++attempt) {
+					std::size_t worst = 0;
+					for (std::size_t i = 1; i < n; ++i) if (better(fitness[worst].load(), fitness[i].load())) worst = i;
+					YType seen = fitness[worst].load();
+					std::lock_guard<std::mutex> lock(locks[worst]);
+					if (!better(y, population.y(worst))) {
+						if (same(seen, population.y(worst))) break; //Still the worst, and not better than it
+						continue;
+					}
+					std::swap(population.x(worst), child);
+					population.y(worst) = y;
+					fitness[worst] = y;
+					inserted = true;
+				}
+				if (!crossing) {
+					++trials;
+					if (inserted && better(y, parent_fitness)) ++successes;
+				}
+				if (!std::isnan(y) && (y <= threshold)) done = true;
+
+				if (((k + 1) % n) == 0) {
+					std::lock_guard<std::mutex> log_lock(log_mutex);
+					for (std::size_t i = 0; i < n; ++i) {
+						std::lock_guard<std::mutex> lock(locks[i]);
+						snapshot.assign(i, population, i);
+					}
+					if constexpr (AdaptiveMutationFunction<FMutation>) mutate.adapt(successes.exchange(0), trials.exchange(0));
+					monitor.evaluated(n);
+					monitor.iteration(snapshot.begin(), snapshot.end());
+					logger.log(++generation, snapshot.begin(), snapshot.end());
+					if (monitor.stop()) done = true;
+				}
+			}
+		});
+
+		std::size_t best = 0;
+		for (std::size_t i = 1; i < n; ++i) if (better(population.y(i), population.y(best))) best = i;
+		return population.x(best);
+	}
+};
+
+GeneticSteadyState steady_state(unsigned long evaluations = 10000, unsigned int population = 20, float crossover_rate = 0.5f, unsigned int tournament = 2,
+		unsigned long seed = (std::random_device())(), unsigned int threads = 0, const stopping& stop = stopping()) {
+	return GeneticSteadyState(evaluations, population, crossover_rate, tournament, seed, threads, stop);
+}
+
+} // namespace opt
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "concepts.h"
+#include "evaluation.h"
+#include "selection.h"
+#include "population.h"
+#include "offspring.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include "../../utils/profile.h"
+#include "../../utils/checkpoint.h"
 #include <iostream>
 #include <type_traits>
 #include <vector>
@@ -23,89 +31,214 @@ private:
 	unsigned int   nmutations_;		// number of mutations per iteration
 	unsigned int   ncrossovers_;    // number of crossovers per iteration
 	unsigned long  seed_;			// The seed for the random number generator (random by default)
+	unsigned int   nthreads_;		// number of threads for generating and evaluating offspring (1 = sequential)
+	SelectionPolicy selection_;		// how the surviving population is sampled (see selection.h)
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h)
+	checkpoint     checkpoint_;		// periodic saving of the state, and resuming from it (see ../../utils/checkpoint.h)
+
+	// Independent random stream for one offspring slot, so that parallel generations do not depend on
+	// the order in which the threads pick up the slots. The stream is the iteration (from 1, as the stream 0
+	// is the sequential generator) and the substream the stage and the slot, so creating it costs nothing.
+	static philox slot_random(unsigned long seed, unsigned long iter, unsigned int stage, unsigned int slot) {
+		return philox(seed, std::uint32_t(iter), (std::uint32_t(stage) << 31) | std::uint32_t(slot));
+	}
+
+	// Working storage for the selection, kept along the iterations so that they do not allocate
+	template<typename YType>
+	struct SelectionWorkspace {
+		std::vector<YType> probability;
+		std::vector<std::size_t> chosen;
+		selection::fenwick_tree<double> tree;
+	};
 
 	template<typename XType, typename YType>
 	requires std::is_floating_point_v<YType>
-	void selection(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		       const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		       const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, std::mt19937& random) const
+	void selection(const Population<XType, YType>& source, Population<XType, YType>& target, philox& random,
+	               SelectionWorkspace<YType>& workspace) const
 	{
-		//First we put the best one to the first position (*target_begin).
-		auto it_to_min = std::min_element(source_begin, source_end, 
-				[] (const std::tuple<XType, YType>& a, const std::tuple<XType, YType>& b) 
-					{ return std::isfinite(std::get<1>(a)) && (std::get<1>(a) < std::get<1>(b)); });
-		*target_begin = *it_to_min;
-		//Warning, the iterator "target_begin" should have "npopulation_" elements left.
-		std::vector<YType> probability(source_end - source_begin);
-		YType furthest = std::accumulate(source_begin, source_end, YType(0), 
-			[] (YType a, const std::tuple<XType,YType>& b) { 
-				return (std::isfinite(std::get<1>(b)) && std::get<1>(b)>a)?std::get<1>(b):a;});
-		std::transform(source_begin, source_end, probability.begin(), 
-			[furthest] (const std::tuple<XType,YType>& e) { 
-				return std::isfinite(std::get<1>(e))?
-					(((furthest+YType(1)-std::get<1>(e)))/(furthest + YType(1))):YType(0); });
+		//Warning, the "target" population should have at least "npopulation_" elements.
+		span<const YType> fitness = source.fitness();
+		//First we put the best one to the first position.
+		std::size_t best = std::min_element(fitness.begin(), fitness.end(), 
+				[] (YType a, YType b) { return std::isfinite(a) && (a < b); }) - fitness.begin();
+		target.assign(0, source, best);
+		std::vector<YType>& probability = workspace.probability;
+		probability.resize(fitness.size());
+		YType furthest = std::accumulate(fitness.begin(), fitness.end(), YType(0), 
+			[] (YType a, YType b) { return (std::isfinite(b) && b>a)?b:a;});
+		std::transform(fitness.begin(), fitness.end(), probability.begin(), 
+			[furthest] (YType e) { 
+				return std::isfinite(e)?(((furthest+YType(1)-e))/(furthest + YType(1))):YType(0); });
 
 		//We set the probability of choosing the best to 0 (we have already chosen it) unless size of probability is 1
-		if (probability.size() > 1) probability[it_to_min - source_begin]= YType(0);
+		if (probability.size() > 1) probability[best]= YType(0);
 
-		//We ensure no repetitions (unless we must because the input population is smaller) but it is much slower...
-		for (unsigned int i = 1; i < npopulation_; ++i) {
-			std::discrete_distribution<int> index(probability.begin(), probability.end());
-			*(target_begin + i) = *(source_begin + index(random));
-			if (probability.size() > npopulation_) probability[i] = YType(0);
+		if (selection_ == SelectionPolicy::discrete) {
+			//We ensure no repetitions (unless we must because the input population is smaller) but it is much slower...
+			for (unsigned int i = 1; i < npopulation_; ++i) {
+				std::discrete_distribution<int> index(probability.begin(), probability.end());
+				target.assign(i, source, index(random));
+				if (probability.size() > npopulation_) probability[i] = YType(0);
+			}
+			//Some element may appear twice or even more...
+		} else {
+			std::vector<std::size_t>& chosen = workspace.chosen;
+			chosen.resize(npopulation_ - 1);
+			if (selection_ == SelectionPolicy::weighted) selection::weighted(probability, chosen.size(), chosen.begin(), random, workspace.tree);
+			else                                         selection::universal(probability, chosen.size(), chosen.begin(), random);
+			for (std::size_t i = 0; i < chosen.size(); ++i) target.assign(i + 1, source, chosen[i]);
 		}
-		//Some element may appear twice or even more...
 	}
 
-	template<typename XType, typename YType, typename FTarget, typename FMutation>
+	//Parents are the first "npopulation_" individuals, mutations are written from the slot "first" on.
+	//The fitness of the parent of each mutation is kept in "parents" (for adaptive mutations).
+	template<typename XType, typename YType, typename FMutation>
 	requires std::is_floating_point_v<YType> &&
-		 TargetFunction<FTarget, XType, YType> &&
-	         MutationFunction<FMutation, XType, std::mt19937> 
-	void mutation(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		      const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		      const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, 
-		      const FTarget& f, const FMutation& mutate, std::mt19937& random) const 
+	         MutationFunction<FMutation, XType, philox> 
+	void mutation(Population<XType, YType>& population, std::size_t first, std::vector<YType>& parents,
+		      const FMutation& mutate, philox& random, thread_pool& pool, unsigned long seed, unsigned long iter) const 
 	{
-		std::uniform_int_distribution<int> index(0, source_end - source_begin - 1);	
-		//Warning, the iterator "target_begin" should have "nmutations_" elements left.
+		if (nthreads_ != 1) { //Even if the pool has a single thread, so that the result does not depend on the machine
+			pool.parallel_for(nmutations_, [&] (std::size_t i) {
+				philox random = slot_random(seed, iter, 0, i);
+				std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
+				std::size_t parent = index(random);
+				parents[i] = population.y(parent);
+				mutate_into(mutate, population.x(parent), population.x(first + i), random);
+			});
+			return;
+		}
+		std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
 		for (unsigned int i = 0; i < nmutations_; ++i) {
-			XType mutated = mutate(std::get<0>(*(source_begin + index(random))), random);
-			*(target_begin + i) = std::tuple(mutated, f(mutated));
+			std::size_t parent = index(random);
+			parents[i] = population.y(parent);
+			mutate_into(mutate, population.x(parent), population.x(first + i), random);
 		}
 	}
 
-	template<typename XType, typename YType, typename FTarget, typename FCrossover>
+	//Parents are the first "npopulation_" individuals, crossovers are written from the slot "first" on
+	template<typename XType, typename YType, typename FCrossover>
 	requires std::is_floating_point_v<YType> &&
-		 TargetFunction<FTarget, XType, YType> &&
-	         CrossoverFunction<FCrossover, XType, std::mt19937> 
-	void crossover(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		      const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		      const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, 
-		      const FTarget& f, const FCrossover& cross, std::mt19937& random) const
+	         CrossoverFunction<FCrossover, XType, philox> 
+	void crossover(Population<XType, YType>& population, std::size_t first,
+		      const FCrossover& cross, philox& random, thread_pool& pool, unsigned long seed, unsigned long iter) const
 	{
-		std::uniform_int_distribution<int> index(0, source_end - source_begin - 1);	
-		//Warning, the iterator "target_begin" should have "nmutations_" elements left.
+		if (nthreads_ != 1) {
+			pool.parallel_for(ncrossovers_, [&] (std::size_t i) {
+				philox random = slot_random(seed, iter, 1, i);
+				std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
+				const XType& parent1 = population.x(index(random));
+				const XType& parent2 = population.x(index(random));
+				cross_into(cross, parent1, parent2, population.x(first + i), random);
+			});
+			return;
+		}
+		std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
 		for (unsigned int i = 0; i < ncrossovers_; ++i) {
-			XType crossed = cross(
-				std::get<0>(*(source_begin + index(random))),
-				std::get<0>(*(source_begin + index(random))),
-					random);
-			*(target_begin + i) = std::tuple(crossed, f(crossed));
-				}
+			cross_into(cross,
+				population.x(index(random)),
+				population.x(index(random)),
+					population.x(first + i), random);
+		}
+	}
+
+	//The state at the beginning of an iteration: the random number generator and the selected population
+	template<typename XType, typename YType>
+	void save(const checkpoint& checkpoints, const std::string& run, unsigned long iter, const philox& random, const stopping::monitor& monitor,
+	          const Population<XType,YType>& population) const {
+		checkpoint::writer writer = checkpoints.save("GeneticStochasticBest", run);
+		writer<<iter<<random<<monitor.saved();
+		for (std::size_t i = 0; i < npopulation_; ++i) writer<<population.x(i)<<population.y(i);
+		writer.commit();
 	}
 
+	//Evolves an evaluated initial population (or the one of the resumed checkpoint, if any). If it is already
+	//selected (the result of a previous run) it is not selected again. The result holds the selected population
+	//in its first npopulation_ slots
+	template<typename XType, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger>
+	Population<XType,YType> run(const Population<XType,YType>& initial_population, const FTarget& f, const FMutation& mutate, const FCrossover& cross, 
+	                            const YType& threshold, Logger& logger, unsigned long iters, unsigned long seed, thread_pool& pool,
+	                            stopping::monitor& monitor, const checkpoint& checkpoints, const std::string& run_id, checkpoint::reader& resumed,
+	                            bool selected = false) const {
+		philox random(seed);
+
+		//The selected population goes first, then the crossovers and then the mutations of each iteration.
+		//We initialized with a value in order to avoid the need of XType to be DefaultConstructible
+		Population<XType,YType> population(npopulation_ + nmutations_ + ncrossovers_, initial_population.x(0));
+		Population<XType,YType> population_next(npopulation_ + nmutations_ + ncrossovers_, initial_population.x(0));		
+
+		SelectionWorkspace<YType> workspace;
+		std::vector<YType> parents(nmutations_), sorted;
+		sorted.reserve(npopulation_);
+		unsigned long first = 0;
+		if (resumed) {
+			stopping::monitor::state state;
+			resumed>>first>>random>>state;
+			for (std::size_t i = 0; i < npopulation_; ++i) resumed>>population.x(i)>>population.y(i);
+			monitor.restore(state);
+		} else if (selected) {
+			std::size_t best = 0;
+			for (std::size_t i = 0; i < npopulation_; ++i) {
+				population.assign(i, initial_population, i % initial_population.size());
+				if (std::isnan(population.y(best)) || (population.y(i) < population.y(best))) best = i;
+			}
+			std::swap(population.x(0), population.x(best)); //The best one goes first, as after a selection
+			std::swap(population.y(0), population.y(best));
+		} else selection(initial_population, population, random, workspace);
+
+		logger.log(first, population.begin(), population.begin() + npopulation_);
+		
+		profiler<ProfilingLogger<Logger>> profiler;
+		for (unsigned long iter = first + 1; (iter<=iters) && (population.y(0)>threshold) && !monitor.stop();++iter) {
+			profiler.begin(iter);
+			{
+				auto timing = profiler.stage(&generation_profile::crossover);
+				crossover(population, npopulation_, cross, random, pool, seed, iter);
+			}
+			{
+				auto timing = profiler.stage(&generation_profile::mutation);
+				mutation(population, npopulation_ + ncrossovers_, parents, mutate, random, pool, seed, iter);
+			}
+			{	//All the offspring are evaluated at once
+				auto timing = profiler.stage(&generation_profile::evaluation);
+				evaluate<XType,YType>(f, population.genes().subspan(npopulation_, ncrossovers_ + nmutations_),
+				                         population.fitness().subspan(npopulation_, ncrossovers_ + nmutations_), pool);
+			}
+			adapt_mutation(mutate, span<const YType>(population.fitness().subspan(0, npopulation_)), span<const YType>(parents), span<const YType>(population.fitness().subspan(npopulation_ + ncrossovers_, nmutations_)), nmutations_, sorted);
+			{
+				auto timing = profiler.stage(&generation_profile::selection);
+				selection(population, population_next, random, workspace); //Unneded in the last iteration
+			}
+			std::swap(population, population_next);
+			monitor.evaluated(ncrossovers_ + nmutations_);
+			monitor.iteration(population.begin(), population.begin() + npopulation_);
+			profiler.evaluated(ncrossovers_ + nmutations_);
+			profiler.end(logger, population.begin(), population.begin() + npopulation_);
+			logger.log(iter, population.begin(), population.begin()+npopulation_);
+			if (checkpoints.due(iter)) save(checkpoints, run_id, iter, random, monitor, population);
+		}
+		return population;
+	}
 
 public:
 	GeneticStochasticBest(unsigned long iters    = 1000,
 		unsigned int npopulation        =   10,
 		unsigned int nmutations         =   10,
 		unsigned int ncrossovers        =   10,
-		unsigned long seed = (std::random_device())()) :
+		unsigned long seed = (std::random_device())(),
+		unsigned int nthreads           =    1,
+		SelectionPolicy selection       = SelectionPolicy::discrete,
+		const stopping& stop            = stopping(),
+		const checkpoint& checkpoints   = checkpoint()) :
 		iters_(iters), 
 		npopulation_(npopulation),
 		nmutations_(nmutations),
 		ncrossovers_(ncrossovers),
-		seed_(seed) 
+		seed_(seed),
+		nthreads_(nthreads),
+		selection_(selection),
+		stop_(stop),
+		checkpoint_(checkpoints)
 	{}
 			
 	/**
@@ -117,43 +250,85 @@ public:
 	 * - XType has support for mutations and crossovers, by the functions FMutation and FCrossover 
 	 * - RNG is a C++11-like random number engine
 	 * - FTarget is a function that, given a XType, returns an YValue: YValue F(XType). 
-	 *   	This is the function to minimize. The ULTIMATE TARGET should be 0
+	 *   	This is the function to minimize. The ULTIMATE TARGET should be 0. Alternatively, it can be a
+	 *   	BatchTargetFunction that evaluates all the offspring of an iteration in a single call.
 	 * - YType is comparable (has support for the binary < operator, returning bool) and can be checked for nans
 	 * - YType can also be accumulated (added), used for random values and initialized from zero
-	 * - OS is an output stream (support for standard binary << and for binary << with XType)
+	 * - Logger receives the population after each iteration (see logger.h)
+	 *
+	 * With nthreads > 1 the offspring are generated and evaluated concurrently, so FTarget, FMutation and
+	 * FCrossover must be safe to call from several threads at once. Each offspring then draws from its own
+	 * random stream derived from the seed, so the result for a given seed is the same for any nthreads other
+	 * than 1, including 0 on a single core machine (although different from the sequential nthreads = 1 run).
+	 *
+	 * With a checkpoint, the state is saved every given number of iterations and, if there is a checkpoint
+	 * file of a run with the same parameters and ini, the method continues from it instead of from ini (which
+	 * is then not evaluated). The file is removed when the method finishes.
 	 **/
 	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger, 
 			typename XType = typename XCollection::value_type>
 	requires std::is_floating_point_v<YType> &&
 	         Container<XCollection> &&
-	         TargetFunction<FTarget, XType, YType> &&
-	         MutationFunction<FMutation, XType, std::mt19937> &&
-	         CrossoverFunction<FCrossover, XType, std::mt19937>
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
 	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, Logger& logger) const {
-		std::mt19937 random(seed_);
+		thread_pool pool(nthreads_);
+		stopping::monitor monitor = stop_.start();
+		checkpoint_.check<XType>();
+		const std::string run_id = checkpoint_.identify(ini.begin(), ini.end(), seed_, iters_, npopulation_, nmutations_, ncrossovers_, int(selection_), nthreads_ != 1);
+		checkpoint::reader resumed = checkpoint_.load("GeneticStochasticBest", run_id);
 		
-		std::vector<std::tuple<XType,YType>> initial_population; //tuple contains both and xvalue and its fitness
-		for (const XType& x: ini) initial_population.push_back(std::tuple(x,f(x)));
-
-		std::vector<std::tuple<XType,YType>> population(npopulation_ + nmutations_ + ncrossovers_, initial_population.front()); //We initialized with a value in order to avoid the need of XType to be DefaultConstructible
-		std::vector<std::tuple<XType,YType>> population_next(npopulation_ + nmutations_ + ncrossovers_, initial_population.front());		
+		Population<XType,YType> initial_population(ini.begin(), ini.end());
+		if (!resumed) {
+			evaluate<XType,YType>(f, initial_population.genes(), initial_population.fitness(), pool);
+			monitor.evaluated(initial_population.size());
+		}
 
-		selection<XType,YType>(initial_population.begin(), initial_population.end(), population.begin(), random);
+		//Obtain the minimum in the big population (selection puts it on the first position)
+		XType best = run(initial_population, f, mutate, cross, threshold, logger, iters_, seed_, pool, monitor, checkpoint_, run_id, resumed).x(0);
+		checkpoint_.finish();
+		return best;
+	}
 
-		logger.log(0, population.begin(), population.begin() + npopulation_);
-		
-		for (unsigned long iter = 1; (iter<=iters_) && (std::get<1>(population[0])>threshold);++iter) {
-			crossover<XType,YType>(population.begin(), population.begin() + npopulation_, 
-					population.begin() + npopulation_, f, cross, random);
-			mutation<XType,YType>(population.begin(), population.begin() + npopulation_, 
-					population.begin() + npopulation_ + ncrossovers_, f, mutate, random);
-			selection<XType,YType>(population.begin(), population.end(), population_next.begin(), random); //Unneded in the last iteration
-			std::swap(population, population_next);
-			logger.log(iter, population.begin(), population.begin()+npopulation_);
-		}
+	/**
+	 * Runs iters iterations starting from an already evaluated population and returns the selected population 
+	 * of the last iteration (npopulation individuals, the best one first). The seed replaces the one of the 
+	 * method, so that a sequence of calls (as the islands in GeneticIslands) can draw different random numbers.
+	 * If ini is already selected (as the result of a previous call), selected avoids selecting from it again,
+	 * which would needlessly lose diversity at each call. The additional stopping criteria of the method are not
+	 * checked, as they refer to the whole sequence, but those of the given monitor (which counts the evaluations)
+	 * are checked at every iteration.
+	 **/
+	template<typename XType, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger>
+	requires std::is_floating_point_v<YType> &&
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	Population<XType,YType> evolve(const Population<XType,YType>& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, 
+	                               const YType& threshold, Logger& logger, unsigned long iters, unsigned long seed, bool selected = false) const {
+		stopping::monitor monitor = stopping().start();
+		return evolve(ini, f, mutate, cross, threshold, logger, iters, seed, monitor, selected);
+	}
 
-		return std::get<0>(population[0]); //Obtain the minimum in the big population (selection puts it on the first position)
+	template<typename XType, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger>
+	requires std::is_floating_point_v<YType> &&
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	Population<XType,YType> evolve(const Population<XType,YType>& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, 
+	                               const YType& threshold, Logger& logger, unsigned long iters, unsigned long seed, stopping::monitor& monitor,
+	                               bool selected = false) const {
+		thread_pool pool(nthreads_);
+		checkpoint::reader none;
+		Population<XType,YType> population = run(ini, f, mutate, cross, threshold, logger, iters, seed, pool, monitor, checkpoint(), std::string(), none, selected);
+		Population<XType,YType> result(npopulation_, population.x(0));
+		for (std::size_t i = 0; i < npopulation_; ++i) result.assign(i, population, i);
+		return result;
 	}
+
+	unsigned long iterations() const { return iters_; }
+	unsigned int population_size() const { return npopulation_; }
 };
 
 
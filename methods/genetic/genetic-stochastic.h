@@ -1,6 +1,13 @@
 #pragma once
 
 #include "concepts.h"
+#include "evaluation.h"
+#include "population.h"
+#include "offspring.h"
+#include "../../utils/stopping.h"
+#include "../../utils/profile.h"
+#include "../../utils/checkpoint.h"
+#include "logger.h"
 #include <iostream>
 #include <type_traits>
 #include <vector>
@@ -23,93 +30,79 @@ private:
 	unsigned int   nmutations_;	// number of mutations per iteration
 	unsigned int   ncrossovers_;    // number of crossovers per iteration
 	unsigned long  seed_;		// The seed for the random number generator (random by default)
+	stopping       stop_;		// additional stopping criteria (see ../../utils/stopping.h)
+	checkpoint     checkpoint_;	// periodic saving of the state, and resuming from it (see ../../utils/checkpoint.h)
 
 	template<typename XType, typename YType>
 	requires std::is_floating_point_v<YType>
-	void selection(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		       const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		       const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, std::mt19937& random) const
+	void selection(const Population<XType, YType>& source, Population<XType, YType>& target, philox& random) const
 	{
-		//Warning, the iterator "target_begin" should have "npopulation_" elements left.
-		std::vector<YType> probability(source_end - source_begin);
-		YType furthest = std::accumulate(source_begin, source_end, YType(0), 
-			[] (YType a, const std::tuple<XType,YType>& b) { 
-				return (std::isfinite(std::get<1>(b)) && std::get<1>(b)>a)?std::get<1>(b):a;});
-		std::transform(source_begin, source_end, probability.begin(), 
-			[furthest] (const std::tuple<XType,YType>& e) { 
-				return std::isfinite(std::get<1>(e))?
-					(((furthest+YType(1)-std::get<1>(e)))/(furthest + YType(1))):YType(0); });
+		//Warning, the "target" population should have at least "npopulation_" elements.
+		span<const YType> fitness = source.fitness();
+		std::vector<YType> probability(fitness.size());
+		YType furthest = std::accumulate(fitness.begin(), fitness.end(), YType(0), 
+			[] (YType a, YType b) { return (std::isfinite(b) && b>a)?b:a;});
+		std::transform(fitness.begin(), fitness.end(), probability.begin(), 
+			[furthest] (YType e) { 
+				return std::isfinite(e)?(((furthest+YType(1)-e))/(furthest + YType(1))):YType(0); });
 /*		std::cerr<<"[prob] -> ";
 		std::for_each(probability.begin(), probability.end(), [] (const YType& p) { std::cerr<<p<<" | "; });
 		std::cerr<<std::endl;*/
 
 		std::discrete_distribution<int> index(probability.begin(), probability.end());
-		for (unsigned int i = 0; i < npopulation_; ++i) *(target_begin + i) = *(source_begin + index(random));
+		for (unsigned int i = 0; i < npopulation_; ++i) target.assign(i, source, index(random));
 		//Some element may appear twice or even more...
 	}
 
-	template<typename XType, typename YType, typename FTarget, typename FMutation>
+	//Parents are the first "npopulation_" individuals, mutations are written from the slot "first" on.
+	//The fitness of the parent of each mutation is kept in "parents" (for adaptive mutations).
+	template<typename XType, typename YType, typename FMutation>
 	requires std::is_floating_point_v<YType> &&
-		 TargetFunction<FTarget, XType, YType> &&
-	         MutationFunction<FMutation, XType, std::mt19937> 
-	void mutation(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		      const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		      const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, 
-		      const FTarget& f, const FMutation& mutate, std::mt19937& random) const 
+	         MutationFunction<FMutation, XType, philox> 
+	void mutation(Population<XType, YType>& population, std::size_t first, std::vector<YType>& parents, const FMutation& mutate, philox& random) const 
 	{
-		std::uniform_int_distribution<int> index(0, source_end - source_begin - 1);	
-		//Warning, the iterator "target_begin" should have "nmutations_" elements left.
+		std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
 		for (unsigned int i = 0; i < nmutations_; ++i) {
-			XType mutated = mutate(std::get<0>(*(source_begin + index(random))), random);
-			*(target_begin + i) = std::tuple(mutated, f(mutated));
+			std::size_t parent = index(random);
+			parents[i] = population.y(parent);
+			mutate_into(mutate, population.x(parent), population.x(first + i), random);
 		}
 	}
 
-	template<typename XType, typename YType, typename FTarget, typename FCrossover>
+	//Parents are the first "npopulation_" individuals, crossovers are written from the slot "first" on
+	template<typename XType, typename YType, typename FCrossover>
 	requires std::is_floating_point_v<YType> &&
-		 TargetFunction<FTarget, XType, YType> &&
-	         CrossoverFunction<FCrossover, XType, std::mt19937> 
-	void crossover(const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		      const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, 
-		      const typename std::vector<std::tuple<XType, YType>>::iterator& target_begin, 
-		      const FTarget& f, const FCrossover& cross, std::mt19937& random) const
+	         CrossoverFunction<FCrossover, XType, philox> 
+	void crossover(Population<XType, YType>& population, std::size_t first, const FCrossover& cross, philox& random) const
 	{
-		std::uniform_int_distribution<int> index(0, source_end - source_begin - 1);	
-		//Warning, the iterator "target_begin" should have "nmutations_" elements left.
+		std::uniform_int_distribution<int> index(0, npopulation_ - 1);	
 		for (unsigned int i = 0; i < ncrossovers_; ++i) {
-			XType crossed = cross(
-				std::get<0>(*(source_begin + index(random))),
-				std::get<0>(*(source_begin + index(random))),
-					random);
-			*(target_begin + i) = std::tuple(crossed, f(crossed));
+			cross_into(cross,
+				population.x(index(random)),
+				population.x(index(random)),
+					population.x(first + i), random);
 		}
 	}
 
-	template<typename XType, typename YType, typename OS> 
-	void stream(unsigned long iter, const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_begin, 
-		   const typename std::vector<std::tuple<XType, YType>>::const_iterator& source_end, OS& os) const {
-
-		os<<"["<<std::setw(4)<<iter<<"] -> ";
-		std::for_each(source_begin, source_end, [&os] (const std::tuple<XType, YType>& t) {
-				os<<std::get<0>(t)<<" ("<<std::get<1>(t)<<") | "; });
-		os<<std::endl;
-	}
-
 public:
 	GeneticStochastic(unsigned int iters    = 1000,
 		unsigned int npopulation        =   10,
 		unsigned int nmutations         =   10,
 		unsigned int ncrossovers        =   10,
-		unsigned long seed = (std::random_device())()) :
+		unsigned long seed = (std::random_device())(),
+		const stopping& stop            = stopping(),
+		const checkpoint& checkpoints   = checkpoint()) :
 		iters_(iters), 
 		npopulation_(npopulation),
 		nmutations_(nmutations),
 		ncrossovers_(ncrossovers),
-		seed_(seed) 
+		seed_(seed),
+		stop_(stop),
+		checkpoint_(checkpoints)
 	{}
 			
 	/**
-	 * Minimizes the function f, giving an initial population ini, and logs the process in the output stream os. The
+	 * Minimizes the function f, giving an initial population ini, and logs the process with the logger. The
 	 * threshold defines a value below which we consider the outcome good enough
 	 *
 	 * - XCollection is an iterable collection of XType, which is the initial population. It must have at least 
@@ -117,47 +110,100 @@ public:
 	 * - XType has support for mutations and crossovers, by the functions FMutation and FCrossover 
 	 * - RNG is a C++11-like random number engine
 	 * - FTarget is a function that, given a XType, returns an YValue: YValue F(XType). 
-	 *   	This is the function to minimize. The ULTIMATE TARGET should be 0
+	 *   	This is the function to minimize. The ULTIMATE TARGET should be 0. Alternatively, it can be a
+	 *   	BatchTargetFunction that evaluates all the offspring of an iteration in a single call.
 	 * - YType is comparable (has support for the binary < operator, returning bool) and can be checked for nans
 	 * - YType can also be accumulated (added), used for random values and initialized from zero
-	 * - OS is an output stream (support for standard binary << and for binary << with XType)
+	 * - Logger receives the selected population after each iteration (see logger.h)
+	 *
+	 * With a checkpoint, the state is saved every given number of iterations and, if there is a checkpoint
+	 * file of a run with the same parameters and ini, the method continues from it instead of from ini (which
+	 * is then not evaluated). The file is removed when the method finishes.
 	 **/
-	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename OS, 
+	template<typename XCollection, typename FTarget, typename FMutation, typename FCrossover, typename YType, typename Logger, 
 			typename XType = typename XCollection::value_type>
 	requires std::is_floating_point_v<YType> &&
 	         Container<XCollection> &&
-	         TargetFunction<FTarget, XType, YType> &&
-	         MutationFunction<FMutation, XType, std::mt19937> &&
-	         CrossoverFunction<FCrossover, XType, std::mt19937>
-	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, OS& os) const {
-		std::mt19937 random(seed_);
+	         (TargetFunction<FTarget, XType, YType> || BatchTargetFunction<FTarget, XType, YType>) &&
+	         MutationFunction<FMutation, XType, philox> &&
+	         CrossoverFunction<FCrossover, XType, philox>
+	XType minimize(const XCollection& ini, const FTarget& f, const FMutation& mutate, const FCrossover& cross, const YType& threshold, Logger& logger) const {
+		philox random(seed_);
+		stopping::monitor monitor = stop_.start();
+		checkpoint_.check<XType>();
+		const std::string run_id = checkpoint_.identify(ini.begin(), ini.end(), seed_, iters_, npopulation_, nmutations_, ncrossovers_);
+		checkpoint::reader resumed = checkpoint_.load("GeneticStochastic", run_id);
 		
-		std::vector<std::tuple<XType,YType>> initial_population; //tuple contains both and xvalue and its fitness
-		for (const XType& x: ini) initial_population.push_back(std::tuple(x,f(x)));
-
-		std::vector<std::tuple<XType,YType>> population(npopulation_ + nmutations_ + ncrossovers_);
-		std::vector<std::tuple<XType,YType>> population_next(npopulation_ + nmutations_ + ncrossovers_);		
-
-		selection<XType,YType>(initial_population.begin(), initial_population.end(), population.begin(), random);
+		Population<XType,YType> initial_population(ini.begin(), ini.end());
+		if (!resumed) {
+			evaluate<XType,YType>(f, initial_population.genes(), initial_population.fitness());
+			monitor.evaluated(initial_population.size());
+		}
 
-		stream<XType,YType>(0, population.begin(), population.begin() + npopulation_, os);
+		//The selected population goes first, then the crossovers and then the mutations of each iteration
+		Population<XType,YType> population(npopulation_ + nmutations_ + ncrossovers_, initial_population.x(0));
+		Population<XType,YType> population_next(npopulation_ + nmutations_ + ncrossovers_, initial_population.x(0));		
+
+		std::vector<YType> parents(nmutations_), sorted;
+		sorted.reserve(npopulation_);
+		unsigned long first = 0;
+		if (resumed) {
+			stopping::monitor::state state;
+			resumed>>first>>random>>state;
+			for (std::size_t i = 0; i < npopulation_; ++i) resumed>>population.x(i)>>population.y(i);
+			monitor.restore(state);
+		} else selection(initial_population, population, random);
+
+		logger.log(first, population.begin(), population.begin() + npopulation_);
 		
 		//The threshold is almost ignored but it is fast because we only find the best in the
 		//end
-		for (unsigned long iter = 1; (iter<=iters_) && (std::get<1>(population[0])>threshold);++iter) {
-			crossover<XType,YType>(population.begin(), population.begin() + npopulation_, 
-					population.begin() + npopulation_, f, cross, random);
-			mutation<XType,YType>(population.begin(), population.begin() + npopulation_, 
-					population.begin() + npopulation_ + ncrossovers_, f, mutate, random);
-			selection<XType,YType>(population.begin(), population.end(), population_next.begin(), random); //Unneded in the last iteration
+		profiler<ProfilingLogger<Logger>> profiler;
+		bool evolved = false;
+		for (unsigned long iter = first + 1; (iter<=iters_) && (population.y(0)>threshold) && !monitor.stop();++iter) {
+			profiler.begin(iter);
+			{
+				auto timing = profiler.stage(&generation_profile::crossover);
+				crossover(population, npopulation_, cross, random);
+			}
+			{
+				auto timing = profiler.stage(&generation_profile::mutation);
+				mutation(population, npopulation_ + ncrossovers_, parents, mutate, random);
+			}
+			{	//All the offspring are evaluated at once
+				auto timing = profiler.stage(&generation_profile::evaluation);
+				evaluate<XType,YType>(f, population.genes().subspan(npopulation_, ncrossovers_ + nmutations_),
+				                         population.fitness().subspan(npopulation_, ncrossovers_ + nmutations_));
+			}
+			adapt_mutation(mutate, span<const YType>(population.fitness().subspan(0, npopulation_)), span<const YType>(parents), span<const YType>(population.fitness().subspan(npopulation_ + ncrossovers_, nmutations_)), nmutations_, sorted);
+			{
+				auto timing = profiler.stage(&generation_profile::selection);
+				selection(population, population_next, random); //Unneded in the last iteration
+			}
 			std::swap(population, population_next);
-			stream<XType,YType>(iter, population.begin(), population.begin() + npopulation_, os);
+			evolved = true;
+			monitor.evaluated(ncrossovers_ + nmutations_);
+			monitor.iteration(population.begin(), population.begin() + npopulation_);
+			profiler.evaluated(ncrossovers_ + nmutations_);
+			profiler.end(logger, population.begin(), population.begin() + npopulation_);
+			logger.log(iter, population.begin(), population.begin() + npopulation_);
+			if (checkpoint_.due(iter)) {
+				checkpoint::writer writer = checkpoint_.save("GeneticStochastic", run_id);
+				writer<<iter<<random<<monitor.saved();
+				for (std::size_t i = 0; i < npopulation_; ++i) writer<<population.x(i)<<population.y(i);
+				writer.commit();
+			}
 		}
 
-		return std::get<0>(std::accumulate(population_next.begin() + 1, population_next.end(), population_next.front(), 
-			[] (const std::tuple<XType, YType>& a, const std::tuple<XType, YType>& b) {
-				return (std::get<1>(a) < std::get<1>(b))?a:b;
-			})); //Obtain the minimum in the big population.
+		//Obtain the minimum in the big population, or in the selected one if no iteration ran (as when
+		//resuming from a checkpoint of the last iteration)
+		const Population<XType,YType>& last = evolved?population_next:population;
+		std::size_t size = evolved?last.size():std::size_t(npopulation_);
+		std::size_t best = 0;
+		for (std::size_t i = 1; i < size; ++i) 
+			if (!(last.y(best) < last.y(i))) best = i;
+		checkpoint_.finish();
+		return last.x(best);
 	}
 };
 
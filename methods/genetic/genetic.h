@@ -3,6 +3,9 @@
 #include "genetic-best.h"
 #include "genetic-stochastic.h"
 #include "genetic-stochastic-best.h"
+#include "genetic-islands.h"
+#include "genetic-steady-state.h"
+#include "selection.h"
 #include "bitwise.h"
 #include "vector.h"
 #include "tuple.h"
@@ -10,13 +13,15 @@
 #include "concepts.h"
 #include "mutation.h"
 #include "real.h"
+#include "adaptive.h"
 #include "int.h"
 #include "minimize.h"
 
 namespace opt {
 
-GeneticStochasticBest genetic(unsigned int iterations = 10000, unsigned int population = 20, unsigned int mutations = 20, unsigned int crossovers = 40, unsigned long seed =  (std::random_device())()) {
-	return GeneticStochasticBest(iterations, population, mutations, crossovers, seed);
+GeneticStochasticBest genetic(unsigned int iterations = 10000, unsigned int population = 20, unsigned int mutations = 20, unsigned int crossovers = 40, unsigned long seed =  (std::random_device())(), unsigned int threads = 1, SelectionPolicy selection = SelectionPolicy::discrete, const stopping& stop = stopping(),
+		const checkpoint& checkpoints = checkpoint()) {
+	return GeneticStochasticBest(iterations, population, mutations, crossovers, seed, threads, selection, stop, checkpoints);
 }
 
 }; // namespace opt
@@ -13,7 +13,7 @@ requires std::is_integral_v<I>
 class int_uniform {
 	I imin, imax;
 public:
-	int_uniform(I imin, I irmax) :
+	int_uniform(I imin, I imax) :
 		imin(imin), imax(imax) { }
 		
 	template<typename RNG>
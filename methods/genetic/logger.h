@@ -1,9 +1,18 @@
 #pragma once
 
+#include "../../utils/profile.h"
+#include <iomanip>
+#include <algorithm>
+#include <tuple>
 
 namespace opt {
 namespace genetic_logger {
 
+/**
+ * Loggers receive the population after each iteration (as a range of (genes, value) tuples or pairs). They are
+ * template parameters of the methods, so the calls to the null logger are inlined into nothing and quiet runs
+ * do not pay for logging.
+ **/
 class null {
 public:
 	template<typename Iterator>
@@ -12,6 +21,22 @@ public:
 
 
 
+namespace detail {
+	//Genes that cannot be written directly are written element by element, as <a , b>
+	template<typename OS, typename T>
+	void stream_genes(OS& os, const T& x) {
+		if constexpr (requires(OS& os, const T& x) { os<<x; }) os<<x;
+		else {
+			os<<"<";
+			for (auto xi = std::begin(x); xi != std::end(x); ++xi) {
+				if (xi != std::begin(x)) os<<" , ";
+				stream_genes(os, *xi);
+			}
+			os<<">";
+		}
+	}
+}
+
 template<typename OS>
 class Stream {
 	OS& os;
@@ -21,7 +46,8 @@ public:
 	void log(unsigned long iteration, const Iterator& begin, const Iterator& end) {
 		os<<"["<<std::setw(4)<<iteration<<"] -> ";
 			std::for_each(begin, end, [this] (const auto& t) {
-				this->os<<std::get<0>(t)<<" ("<<std::get<1>(t)<<") | "; });
+				detail::stream_genes(this->os, std::get<0>(t));
+				this->os<<" ("<<std::get<1>(t)<<") | "; });
 		os<<std::endl;
 
 	}
@@ -30,6 +56,34 @@ public:
 template<typename OS>
 Stream<OS> stream(OS& os) { return Stream<OS>(os); }
 
+/**
+ * Writes the profile of each iteration (see ../../utils/profile.h) as a line of CSV, after a header line:
+ * iteration,selection,mutation,crossover,evaluation,evaluations,allocations,best,mean
+ * where the times of the stages are in seconds. The population itself is not logged.
+ **/
+template<typename OS>
+class Profile {
+	OS& os;
+	bool header = true;
+public:
+	Profile(OS& os) : os(os) {}
+	template<typename Iterator>
+	void log(unsigned long iteration, const Iterator& begin, const Iterator& end) {}
+
+	void profile(const generation_profile& p) {
+		if (header) {
+			os<<"iteration,selection,mutation,crossover,evaluation,evaluations,allocations,best,mean\n";
+			header = false;
+		}
+		os<<p.iteration<<","<<p.selection<<","<<p.mutation<<","<<p.crossover<<","<<p.evaluation<<","
+		  <<p.evaluations<<","<<p.allocations<<","<<p.best<<","<<p.mean<<"\n";
+	}
+};
+
+template<typename OS>
+Profile<OS> profile(OS& os) { return Profile<OS>(os); }
+
+
 
 }
 }
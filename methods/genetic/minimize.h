@@ -8,7 +8,6 @@
 #include "initialization.h"
 #include "logger.h"
 #include <callable/callable.hpp>
-#include "../../utils/null-ostream.h"
 #include "../../utils/concepts.h"
 
 namespace opt {
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "concepts.h"
+#include "../../utils/span.h"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Writes a mutation of x into target. Operators with an in place version write directly on target,
+ * reusing its storage, so that no allocation happens once the population slots have grown.
+ **/
+template<typename XType, typename FMutation, typename RNG>
+requires MutationFunction<FMutation, XType, RNG>
+void mutate_into(const FMutation& mutate, const XType& x, XType& target, RNG& random) {
+	if constexpr (InPlaceMutationFunction<FMutation, XType, RNG>) mutate(x, target, random);
+	else target = mutate(x, random);
+}
+
+/**
+ * Writes the crossover of x1 and x2 into target, in place if the operator supports it.
+ **/
+template<typename XType, typename FCrossover, typename RNG>
+requires CrossoverFunction<FCrossover, XType, RNG>
+void cross_into(const FCrossover& cross, const XType& x1, const XType& x2, XType& target, RNG& random) {
+	if constexpr (InPlaceCrossoverFunction<FCrossover, XType, RNG>) cross(x1, x2, target, random);
+	else target = cross(x1, x2, random);
+}
+
+/**
+ * Reports to an adaptive mutation (see AdaptiveMutationFunction) how many of the "trials" mutations of a
+ * generation were successful (those not given count as failures). A mutation succeeds if it improves both
+ * the parent it comes from and the median of the population the parents were chosen from: otherwise,
+ * when poor individuals survive (as in stochastic selection), mutations that are far too large would
+ * still improve them and the step size would grow without bound. Nothing happens for the rest of mutations.
+ * The median is found in sorted, which the engine reserves once for the size of the population so that no
+ * allocation happens at each generation.
+ **/
+template<typename FMutation, typename YType>
+void adapt_mutation(const FMutation& mutate, span<const YType> population, span<const YType> parents, span<const YType> mutations, unsigned long trials,
+                    std::vector<YType>& sorted) {
+	if constexpr (AdaptiveMutationFunction<FMutation>) {
+		sorted.clear();
+		for (YType y : population) if (!std::isnan(y)) sorted.push_back(y);
+		YType median = std::numeric_limits<YType>::infinity();
+		if (!sorted.empty()) {
+			std::nth_element(sorted.begin(), sorted.begin() + sorted.size()/2, sorted.end());
+			median = sorted[sorted.size()/2];
+		}
+		unsigned long successes = 0;
+		for (std::size_t i = 0; i < mutations.size(); ++i) if ((mutations[i] < parents[i]) && (mutations[i] < median)) ++successes;
+		mutate.adapt(successes, trials);
+	}
+}
+
+} // namespace opt
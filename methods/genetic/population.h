@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <iterator>
+#include <type_traits>
+#include "../../utils/span.h"
+#include "../../utils/aligned-allocator.h"
+
+namespace opt {
+
+/**
+ * Storage for the genes of a population. Genomes that are fixed-size arrays of real numbers are
+ * stored as a contiguous, cache-line aligned matrix (one row per individual). Any other genome
+ * (including std::vector, whose length may change during the optimization) is stored in a plain
+ * vector whose slots are reused from one iteration to the next, so assigning to them does not
+ * reallocate when the size does not change.
+ **/
+template<typename XType>
+struct population_genes {
+	using type = std::vector<XType>;
+};
+
+template<typename R, std::size_t N>
+requires std::is_floating_point_v<R>
+struct population_genes<std::array<R,N>> {
+	using type = std::vector<std::array<R,N>, aligned_allocator<std::array<R,N>>>;
+};
+
+/**
+ * Population of a genetic algorithm stored as a structure of arrays: the genes of all individuals on
+ * one side and their fitness values, contiguous, on the other. This way selection only streams
+ * through the fitness values and a range of individuals can be evaluated as a span of genes.
+ *
+ * Iterating over the population gives (gene, fitness) tuples of references, as loggers expect.
+ **/
+template<typename XType, typename YType>
+class Population {
+	typename population_genes<XType>::type      x_;
+	std::vector<YType, aligned_allocator<YType>> y_;
+public:
+	Population(std::size_t size, const XType& x, const YType& y = YType(0)) :
+		x_(size, x), y_(size, y) { }
+
+	template<typename Iterator>
+	requires requires(Iterator it) { *it; ++it; }
+	Population(const Iterator& begin, const Iterator& end) :
+		x_(begin, end), y_(x_.size(), YType(0)) { }
+
+	std::size_t size() const { return x_.size(); }
+
+	XType&       x(std::size_t i)       { return x_[i]; }
+	const XType& x(std::size_t i) const { return x_[i]; }
+	YType&       y(std::size_t i)       { return y_[i]; }
+	const YType& y(std::size_t i) const { return y_[i]; }
+
+	//Copies the individual "j" of "that" into the slot "i" (reusing the slot's storage)
+	void assign(std::size_t i, const Population& that, std::size_t j) {
+		x_[i] = that.x_[j]; y_[i] = that.y_[j];
+	}
+
+	span<XType>       genes()         { return span<XType>(x_.data(), x_.size()); }
+	span<const XType> genes()   const { return span<const XType>(x_.data(), x_.size()); }
+	span<YType>       fitness()       { return span<YType>(y_.data(), y_.size()); }
+	span<const YType> fitness() const { return span<const YType>(y_.data(), y_.size()); }
+
+	class const_iterator {
+		const Population* p; std::size_t i;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = std::tuple<XType, YType>;
+		using reference         = std::tuple<const XType&, const YType&>;
+		using pointer           = void;
+		using difference_type   = std::ptrdiff_t;
+
+		const_iterator(const Population* p = nullptr, std::size_t i = 0) : p(p), i(i) { }
+		reference operator*() const { return reference(p->x_[i], p->y_[i]); }
+		reference operator[](difference_type n) const { return *((*this) + n); }
+		const_iterator& operator++() { ++i; return *this; }
+		const_iterator  operator++(int) { const_iterator old = *this; ++i; return old; }
+		const_iterator& operator--() { --i; return *this; }
+		const_iterator  operator--(int) { const_iterator old = *this; --i; return old; }
+		const_iterator& operator+=(difference_type n) { i += n; return *this; }
+		const_iterator& operator-=(difference_type n) { i -= n; return *this; }
+		const_iterator  operator+(difference_type n) const { return const_iterator(p, i + n); }
+		const_iterator  operator-(difference_type n) const { return const_iterator(p, i - n); }
+		difference_type operator-(const const_iterator& that) const { return difference_type(i) - difference_type(that.i); }
+		bool operator==(const const_iterator& that) const { return i == that.i; }
+		bool operator!=(const const_iterator& that) const { return i != that.i; }
+		bool operator<(const const_iterator& that)  const { return i <  that.i; }
+	};
+
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end()   const { return const_iterator(this, size()); }
+};
+
+} // namespace opt
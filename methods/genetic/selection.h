@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+namespace opt {
+
+/**
+ * How GeneticStochasticBest picks the individuals that survive each iteration, proportionally to
+ * their (fitness based) weight:
+ * - discrete: a std::discrete_distribution is rebuilt for every pick. This is the original
+ *             strategy, O(npopulation * total) per iteration.
+ * - weighted: weighted sampling without replacement on a Fenwick tree, O(total + npopulation * log(total)).
+ * - universal: stochastic universal sampling (a single spin of a wheel with npopulation equally spaced
+ *             pointers), O(total + npopulation). An individual may be picked more than once if its weight
+ *             is above total/npopulation, but the number of copies of each individual is close to the
+ *             expected one.
+ **/
+enum class SelectionPolicy { discrete, weighted, universal };
+
+namespace selection {
+
+/**
+ * Binary indexed tree over a set of non-negative weights that supports changing a weight and
+ * sampling an index proportionally to the weights, both in logarithmic time.
+ **/
+template<typename W>
+class fenwick_tree {
+	std::vector<W> tree; //1-indexed, tree[0] is unused
+	W total_;
+	std::size_t top;     //Highest power of two not above the size
+public:
+	fenwick_tree() : tree(1, W(0)), total_(0), top(1) { }
+
+	template<typename Iterator>
+	fenwick_tree(const Iterator& begin, const Iterator& end) : fenwick_tree() { assign(begin, end); }
+
+	//Rebuilds the tree over new weights, reusing the storage
+	template<typename Iterator>
+	void assign(const Iterator& begin, const Iterator& end) {
+		tree.resize(1); total_ = W(0); top = 1;
+		tree.insert(tree.end(), begin, end);
+		for (std::size_t i = 1; i < tree.size(); ++i) total_ += tree[i];
+		for (std::size_t i = 1; i < tree.size(); ++i) {
+			std::size_t parent = i + (i & (~i + 1));
+			if (parent < tree.size()) tree[parent] += tree[i];
+		}
+		while ((top << 1) < tree.size()) top <<= 1;
+	}
+
+	std::size_t size() const { return tree.size() - 1; }
+	W total() const { return total_; }
+
+	void add(std::size_t index, W delta) {
+		total_ += delta;
+		for (std::size_t i = index + 1; i < tree.size(); i += (i & (~i + 1))) tree[i] += delta;
+	}
+
+	//Smallest index whose cumulative weight is above u (for u in [0, total))
+	std::size_t find(W u) const {
+		std::size_t pos = 0;
+		for (std::size_t step = top; step > 0; step >>= 1) {
+			if (((pos + step) < tree.size()) && (tree[pos + step] <= u)) {
+				pos += step;
+				u -= tree[pos];
+			}
+		}
+		return std::min(pos, size() - 1);
+	}
+};
+
+/**
+ * Picks count indices (written on out) proportionally to weight, without replacement. If count is larger
+ * than the number of positive weights, the weights are restored once they are exhausted. When all weights
+ * are zero the indices are chosen uniformly. The tree is working storage, which can be kept between calls
+ * to avoid allocations.
+ **/
+template<typename W, typename OutputIterator, typename RNG>
+void weighted(const std::vector<W>& weight, std::size_t count, OutputIterator out, RNG& random, fenwick_tree<double>& tree) {
+	if (weight.empty()) return;
+	tree.assign(weight.begin(), weight.end());
+	double original_total = tree.total();
+	std::uniform_int_distribution<std::size_t> uniform(0, weight.size() - 1);
+	for (std::size_t i = 0; i < count; ++i) {
+		//The threshold absorbs the rounding errors accumulated while removing weights
+		if (tree.total() <= 1.e-9*original_total) {
+			if (original_total <= 0.0) { *out++ = uniform(random); continue; }
+			tree.assign(weight.begin(), weight.end());
+		}
+		std::uniform_real_distribution<double> sample(0.0, tree.total());
+		std::size_t chosen = tree.find(sample(random));
+		*out++ = chosen;
+		tree.add(chosen, -double(weight[chosen]));
+	}
+}
+
+template<typename W, typename OutputIterator, typename RNG>
+void weighted(const std::vector<W>& weight, std::size_t count, OutputIterator out, RNG& random) {
+	fenwick_tree<double> tree;
+	weighted(weight, count, out, random, tree);
+}
+
+/**
+ * Stochastic universal sampling: picks count indices (written on out, in increasing order) proportionally
+ * to weight. When all weights are zero the indices are chosen uniformly.
+ **/
+template<typename W, typename OutputIterator, typename RNG>
+void universal(const std::vector<W>& weight, std::size_t count, OutputIterator out, RNG& random) {
+	if (weight.empty() || (count == 0)) return;
+	double total = 0.0;
+	for (const W& w : weight) total += w;
+	if (total <= 0.0) {
+		std::uniform_int_distribution<std::size_t> uniform(0, weight.size() - 1);
+		for (std::size_t i = 0; i < count; ++i) *out++ = uniform(random);
+		return;
+	}
+	double spacing = total / double(count);
+	std::uniform_real_distribution<double> sample(0.0, spacing);
+	double pointer = sample(random);
+	double cumulative = 0.0;
+	std::size_t index = 0;
+	for (std::size_t i = 0; i < count; ++i, pointer += spacing) {
+		while (((cumulative + weight[index]) <= pointer) && ((index + 1) < weight.size())) cumulative += weight[index++];
+		*out++ = index;
+	}
+}
+
+} // namespace selection
+} // namespace opt
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../../utils/trace.h"
+#include <string>
+
+namespace opt {
+namespace genetic_logger {
+
+/**
+ * Appends the population of each iteration to a binary trace file (see ../../utils/trace.h), with the genomes
+ * if they are trivially copyable and genomes is true. Much faster and smaller than a Stream, for inspecting long
+ * runs afterwards with opt::trace_reader or the trace-dump tool.
+ *
+ * The trace is mapped in memory with POSIX calls, so this header is not included by opt.h.
+ **/
+class Trace {
+	trace_writer writer;
+public:
+	Trace(const std::string& path, bool genomes = true) : writer(path, genomes) {}
+	template<typename Iterator>
+	void log(unsigned long iteration, const Iterator& begin, const Iterator& end) {
+		writer.write(iteration, begin, end);
+	}
+};
+
+Trace trace(const std::string& path, bool genomes = true) { return Trace(path, genomes); }
+
+
+}
+}
@@ -27,6 +27,23 @@ public:
 		return sol;
 	}
 
+	//In place version: writes the mutation of c into sol, reusing its storage
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG> &&
+		 RandomAccessContainer<C> &&
+		 MutationFunction<FMutation, typename C::value_type, RNG>
+	void operator()(const C& c, C& sol, RNG& random) const {
+		sol = c;
+		std::uniform_int_distribution<int> sample(0,c.size()-1);
+		int chosen = sample(random);
+		sol[chosen] = mutate_element(c[chosen], random);
+	}
+
+	//Adaptive element mutations receive the success rate of the whole genome mutations
+	void adapt(unsigned long successes, unsigned long trials) const
+	requires AdaptiveMutationFunction<FMutation> {
+		mutate_element.adapt(successes, trials);
+	}
 };
 
 template<typename FMutation>
@@ -46,6 +63,21 @@ public:
 		return sol;
 	}
 
+	//In place version: writes the mutation of c into sol, reusing its storage
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG> &&
+			 RandomAccessContainer<C> &&
+			 MutationFunction<FMutation, typename C::value_type, RNG>
+	void operator()(const C& c, C& sol, RNG& random) const {
+		sol = c;
+		for (int i = 0; i < int(c.size()); ++i) sol[i] = mutate_element(c[i], random);
+	}
+
+	//Adaptive element mutations receive the success rate of the whole genome mutations
+	void adapt(unsigned long successes, unsigned long trials) const
+	requires AdaptiveMutationFunction<FMutation> {
+		mutate_element.adapt(successes, trials);
+	}
 };
 } //namespace mutation
 
@@ -57,12 +89,21 @@ public:
 			 RandomAccessContainer<C>
 	C operator()(const C& c1, const C& c2, RNG& random) const {
 		C sol = c2;
+		(*this)(c1, c2, sol, random);
+		return sol;
+	}
+
+	//In place version: writes the crossover of c1 and c2 into sol, reusing its storage
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG> && 
+			 RandomAccessContainer<C>
+	void operator()(const C& c1, const C& c2, C& sol, RNG& random) const {
+		if (&sol != &c2) sol = c2;
 		if ((c1.size()>1) && ((c2.size())>1)) {
 			std::uniform_int_distribution<int> sample(1,std::min(c1.size(),c2.size())-1);
 			int chosen = sample(random);
 			for (int i=0 ; i<chosen;++i) sol[i] = c1[i];
 		}
-		return sol;
 	}
 };
 
@@ -73,10 +114,19 @@ public:
 			 RandomAccessContainer<C>
 	C operator()(const C& c1, const C& c2, RNG& random) const {
 		C sol = c2;
+		(*this)(c1, c2, sol, random);
+		return sol;
+	}
+
+	//In place version: writes the crossover of c1 and c2 into sol, reusing its storage
+	template<typename C, typename RNG>
+	requires UniformRandomBitGenerator<RNG> && 
+			 RandomAccessContainer<C>
+	void operator()(const C& c1, const C& c2, C& sol, RNG& random) const {
+		if (&sol != &c2) sol = c2;
 		std::uniform_int_distribution<int> sample(0,1); //Equal probability for both parents
-		for (int i=0 ; (i<std::min(c1.size(),c2.size()));++i) 
+		for (int i=0 ; (i<int(std::min(c1.size(),c2.size())));++i) 
 			if (!sample(random)) sol[i] = c1[i];
-		return sol;
 	}
 };
 
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <iterator>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * Basic linear algebra over containers of real numbers (std::array, std::vector...), as needed by the
+ * gradient based methods.
+ **/
+namespace opt {
+namespace algebra {
+
+template<typename X>
+auto dot(const X& a, const X& b) {
+	using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(a))>>;
+	Real s(0);
+	auto bi = std::begin(b);
+	for (auto ai = std::begin(a); ai != std::end(a); ++ai, ++bi) s += (*ai)*(*bi);
+	return s;
+}
+
+template<typename X>
+auto norm(const X& a) { return std::sqrt(dot(a, a)); }
+
+template<typename X>
+auto max_norm(const X& a) {
+	using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(a))>>;
+	Real m(0);
+	for (auto ai = std::begin(a); ai != std::end(a); ++ai) m = std::max(m, Real(std::abs(*ai)));
+	return m;
+}
+
+//y = y + alpha*x
+template<typename X, typename Real>
+void axpy(Real alpha, const X& x, X& y) {
+	auto xi = std::begin(x);
+	for (auto yi = std::begin(y); yi != std::end(y); ++yi, ++xi) (*yi) += alpha*(*xi);
+}
+
+//z = x - y
+template<typename X>
+void difference(const X& x, const X& y, X& z) {
+	auto xi = std::begin(x); auto yi = std::begin(y);
+	for (auto zi = std::begin(z); zi != std::end(z); ++zi, ++xi, ++yi) (*zi) = (*xi) - (*yi);
+}
+
+template<typename X, typename Real>
+void scale(Real alpha, X& x) {
+	for (auto xi = std::begin(x); xi != std::end(x); ++xi) (*xi) *= alpha;
+}
+
+} // namespace algebra
+} // namespace opt
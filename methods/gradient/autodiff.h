@@ -0,0 +1,121 @@
+#pragma once
+
+#include "concepts.h"
+#include "dual.h"
+#include "tape.h"
+#include <array>
+#include <vector>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace opt {
+
+/**
+ * The same container as X but holding elements of type T (so that a function on std::array<float,N> can be
+ * evaluated on std::array<dual<float>,N> or std::array<var<float>,N>).
+ **/
+template<typename X, typename T>
+struct rebind { };
+
+template<typename R, std::size_t N, typename T>
+struct rebind<std::array<R,N>, T> { using type = std::array<T,N>; };
+
+template<typename R, typename Allocator, typename T>
+struct rebind<std::vector<R,Allocator>, T> { using type = std::vector<T>; };
+
+template<typename X, typename T>
+using rebind_t = typename rebind<X,T>::type;
+
+namespace detail {
+	template<typename X>
+	struct fixed_size : std::false_type { };
+	template<typename R, std::size_t N>
+	struct fixed_size<std::array<R,N>> : std::true_type { };
+
+	//Container of type Y with the same size as x
+	template<typename Y, typename X>
+	Y same_size(const X& x) {
+		Y y;
+		if constexpr (!fixed_size<Y>::value) y.resize(x.size());
+		return y;
+	}
+}
+
+template<typename X>
+using element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<const X&>()))>>;
+
+//Functions written generically on the scalar type, that can be evaluated on reverse mode AD variables
+template<typename F, typename XType>
+concept bool AutoDifferentiableFunction =
+    requires(const F& f, const rebind_t<XType, var<element_t<XType>>>& x, var<element_t<XType>> y) {
+	y = f(x);
+    };
+
+//Functions whose gradient is available, either provided by the function or automatically differentiated
+template<typename F, typename XType>
+concept bool GradientFunction =
+    DifferentiableFunction<F, XType> || AutoDifferentiableFunction<F, XType>;
+
+/**
+ * Gradient of f at x in forward mode: one evaluation of f on dual numbers per dimension. Cheaper than the
+ * reverse mode for few dimensions, as it does not record anything.
+ **/
+template<typename FTarget, typename XType>
+XType forward_gradient(const FTarget& f, const XType& x) {
+	using Real = element_t<XType>;
+	auto xd = detail::same_size<rebind_t<XType, dual<Real>>>(x);
+	for (std::size_t i = 0; i < x.size(); ++i) xd[i] = dual<Real>(x[i]);
+	XType g = x;
+	for (std::size_t i = 0; i < x.size(); ++i) {
+		xd[i] = dual<Real>(x[i], Real(1));
+		g[i] = Real(f(xd).derivative());
+		xd[i] = dual<Real>(x[i]);
+	}
+	return g;
+}
+
+/**
+ * Gradient of f at x in reverse mode: a single evaluation of f recorded in the tape of the current thread
+ * followed by a backwards sweep, so the cost does not grow with the dimension (only the memory does).
+ **/
+template<typename FTarget, typename XType>
+XType reverse_gradient(const FTarget& f, const XType& x) {
+	using Real = element_t<XType>;
+	tape<Real>& t = tape<Real>::current();
+	t.clear();
+	auto xv = detail::same_size<rebind_t<XType, var<Real>>>(x);
+	for (std::size_t i = 0; i < x.size(); ++i) xv[i] = var<Real>(x[i]);
+	var<Real> y = f(xv);
+	const std::vector<Real>& adjoint = t.adjoints(y.index());
+	XType g = x;
+	for (std::size_t i = 0; i < x.size(); ++i) g[i] = adjoint[xv[i].index()];
+	t.clear();
+	return g;
+}
+
+enum class Differentiation { forward, reverse };
+
+/**
+ * Wraps a generic function with a gradient() member computed by automatic differentiation, so that it becomes
+ * a DifferentiableFunction on XType (and, having a non generic operator(), it can be used with opt::minimize).
+ **/
+template<typename XType, typename F>
+class autodiff_function {
+	F f;
+	Differentiation mode;
+public:
+	autodiff_function(const F& f, Differentiation mode = Differentiation::reverse) : f(f), mode(mode) { }
+
+	auto operator()(const XType& x) const { return f(x); }
+	XType gradient(const XType& x) const {
+		return (mode == Differentiation::forward)?forward_gradient(f, x):reverse_gradient(f, x);
+	}
+};
+
+template<typename XType, typename F>
+autodiff_function<XType, F> differentiable(const F& f, Differentiation mode = Differentiation::reverse) {
+	return autodiff_function<XType, F>(f, mode);
+}
+
+} // namespace opt
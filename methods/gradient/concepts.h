@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../pattern-search/logger.h"
+#include "../pattern-search/concepts.h"
+#include <array>
+#include <functional>
+#include <type_traits>
+
+namespace opt {
+
+//Functions that, besides their value, provide their gradient with respect to x (as the same type as x)
+template<typename F, typename XType>
+concept bool DifferentiableFunction =
+    requires(const F& f, const XType& x, XType g) {
+	f(x);
+	g = f.gradient(x);
+    };
+
+namespace detail {
+	//Minimal differentiable function for checking the methods
+	struct differentiable_probe {
+		float operator()(const std::array<float,1>& x) const { return x[0]*x[0]; }
+		std::array<float,1> gradient(const std::array<float,1>& x) const { return std::array<float,1>{{2.0f*x[0]}}; }
+	};
+}
+
+//Methods that minimize differentiable functions from an initial position (see gradient-descent.h and lbfgs.h).
+//Derivative free methods (that also accept differentiable functions) are excluded.
+template <typename Method>
+concept bool GradientMethod =
+    !PatternSearchMethod<Method> &&
+    requires(const Method& m, const detail::differentiable_probe& target, const std::array<float,1>& init, 
+             pattern_search_logger::null& logger, std::array<float,1> sol) {
+	sol = m.minimize(init, target, logger); 
+    };
+
+} // namespace opt
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "concepts.h"
+#include "autodiff.h"
+
+namespace opt {
+
+/**
+ * Gradient of f at x, as provided by the function itself (see DifferentiableFunction)
+ **/
+template<typename FTarget, typename XType>
+requires DifferentiableFunction<FTarget, XType>
+XType gradient_of(const FTarget& f, const XType& x) {
+	return f.gradient(x);
+}
+
+/**
+ * Gradient of f at x for functions that do not provide it but are written generically on the scalar type
+ * (see AutoDifferentiableFunction), by reverse mode automatic differentiation
+ **/
+template<typename FTarget, typename XType>
+requires AutoDifferentiableFunction<FTarget, XType> && (!DifferentiableFunction<FTarget, XType>)
+XType gradient_of(const FTarget& f, const XType& x) {
+	return reverse_gradient(f, x);
+}
+
+} // namespace opt
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <iostream>
+
+namespace opt {
+
+/**
+ * Dual number for forward mode automatic differentiation: a value together with its derivative with respect
+ * to one chosen input. Generic code written for any scalar type (calling math functions unqualified, as
+ * sin(x) instead of std::sin(x), so that they are found for dual numbers) computes both at once.
+ **/
+template<typename Real>
+class dual {
+	Real value_, derivative_;
+public:
+	using value_type = Real;
+
+	constexpr dual(Real value = Real(0), Real derivative = Real(0)) : value_(value), derivative_(derivative) { }
+
+	constexpr Real value() const { return value_; }
+	constexpr Real derivative() const { return derivative_; }
+	explicit constexpr operator Real() const { return value_; }
+
+	dual& operator+=(const dual& that) { value_ += that.value_; derivative_ += that.derivative_; return *this; }
+	dual& operator-=(const dual& that) { value_ -= that.value_; derivative_ -= that.derivative_; return *this; }
+	dual& operator*=(const dual& that) { return (*this) = (*this)*that; }
+	dual& operator/=(const dual& that) { return (*this) = (*this)/that; }
+
+	friend constexpr dual operator-(const dual& a) { return dual(-a.value_, -a.derivative_); }
+	friend constexpr dual operator+(const dual& a) { return a; }
+	friend constexpr dual operator+(const dual& a, const dual& b) { return dual(a.value_ + b.value_, a.derivative_ + b.derivative_); }
+	friend constexpr dual operator-(const dual& a, const dual& b) { return dual(a.value_ - b.value_, a.derivative_ - b.derivative_); }
+	friend constexpr dual operator*(const dual& a, const dual& b) {
+		return dual(a.value_*b.value_, a.derivative_*b.value_ + a.value_*b.derivative_); }
+	friend constexpr dual operator/(const dual& a, const dual& b) {
+		return dual(a.value_/b.value_, (a.derivative_*b.value_ - a.value_*b.derivative_)/(b.value_*b.value_)); }
+
+	friend constexpr bool operator< (const dual& a, const dual& b) { return a.value_ <  b.value_; }
+	friend constexpr bool operator> (const dual& a, const dual& b) { return a.value_ >  b.value_; }
+	friend constexpr bool operator<=(const dual& a, const dual& b) { return a.value_ <= b.value_; }
+	friend constexpr bool operator>=(const dual& a, const dual& b) { return a.value_ >= b.value_; }
+	friend constexpr bool operator==(const dual& a, const dual& b) { return a.value_ == b.value_; }
+	friend constexpr bool operator!=(const dual& a, const dual& b) { return a.value_ != b.value_; }
+
+	friend dual sin(const dual& a)  { return dual(std::sin(a.value_),  a.derivative_*std::cos(a.value_)); }
+	friend dual cos(const dual& a)  { return dual(std::cos(a.value_), -a.derivative_*std::sin(a.value_)); }
+	friend dual tan(const dual& a)  { Real t = std::tan(a.value_); return dual(t, a.derivative_*(Real(1) + t*t)); }
+	friend dual exp(const dual& a)  { Real e = std::exp(a.value_); return dual(e, a.derivative_*e); }
+	friend dual log(const dual& a)  { return dual(std::log(a.value_), a.derivative_/a.value_); }
+	friend dual sqrt(const dual& a) { Real s = std::sqrt(a.value_); return dual(s, a.derivative_/(Real(2)*s)); }
+	friend dual tanh(const dual& a) { Real t = std::tanh(a.value_); return dual(t, a.derivative_*(Real(1) - t*t)); }
+	friend dual atan(const dual& a) { return dual(std::atan(a.value_), a.derivative_/(Real(1) + a.value_*a.value_)); }
+	friend dual abs(const dual& a)  { return (a.value_ < Real(0))?-a:a; }
+	friend dual fabs(const dual& a) { return abs(a); }
+	friend dual pow(const dual& a, Real p) {
+		return dual(std::pow(a.value_, p), a.derivative_*p*std::pow(a.value_, p - Real(1))); }
+	friend dual pow(const dual& a, const dual& b) {
+		Real v = std::pow(a.value_, b.value_);
+		return dual(v, v*(b.derivative_*std::log(a.value_) + b.value_*a.derivative_/a.value_)); }
+
+	//Mixed operations with plain numbers
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator+(const dual& a, S b) { return dual(a.value_ + Real(b), a.derivative_); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator+(S a, const dual& b) { return dual(Real(a) + b.value_, b.derivative_); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator-(const dual& a, S b) { return dual(a.value_ - Real(b), a.derivative_); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator-(S a, const dual& b) { return dual(Real(a) - b.value_, -b.derivative_); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator*(const dual& a, S b) { return dual(a.value_*Real(b), a.derivative_*Real(b)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator*(S a, const dual& b) { return dual(Real(a)*b.value_, Real(a)*b.derivative_); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator/(const dual& a, S b) { return dual(a.value_/Real(b), a.derivative_/Real(b)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr dual operator/(S a, const dual& b) { return dual(Real(a))/b; }
+
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr bool operator<(const dual& a, S b) { return a.value_ < Real(b); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr bool operator<(S a, const dual& b) { return Real(a) < b.value_; }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr bool operator>(const dual& a, S b) { return a.value_ > Real(b); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend constexpr bool operator>(S a, const dual& b) { return Real(a) > b.value_; }
+
+	friend std::ostream& operator<<(std::ostream& os, const dual& a) { return os<<a.value_<<"+"<<a.derivative_<<"e"; }
+};
+
+} // namespace opt
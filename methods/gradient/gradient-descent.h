@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "concepts.h"
+#include "algebra.h"
+#include "line-search.h"
+#include "derivative.h"
+#include <type_traits>
+#include <utility>
+
+namespace opt {
+
+/**
+ * Steepest descent: moves along the negative gradient with a backtracking line search. Each line search starts
+ * with twice the previously accepted step.
+ **/
+class GradientDescent
+{
+private:
+	unsigned int   iters_;			// maximum number of iterations
+	float          tolerance_;		// the method stops when all the components of the gradient are below this
+	float          step_size_;		// first step tried by the line search
+
+public:
+	GradientDescent(unsigned int iters  = 1000,
+		float tolerance               = 1.e-5f,
+		float step_size               = 1.0f) :
+		iters_(iters),
+		tolerance_(tolerance),
+		step_size_(step_size) {}
+
+	/**
+	 * Minimizes f from ini. The logger receives, at each iteration, the step of the last line search, the 
+	 * position and its value (same interface as the pattern search loggers, see ../pattern-search/logger.h)
+	 **/
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 GradientFunction<FTarget, XType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(ini))>>;
+		XType x = ini;
+		YType f_x = f(x);
+		XType g = gradient_of(f, x);
+		XType direction = g, x_next = x;
+		YType f_next;
+		Real step = step_size_;
+
+		for (unsigned int i = 1; (i <= iters_) && (algebra::max_norm(g) > Real(tolerance_)); ++i) {
+			logger.log(i, step, x, f_x);
+			direction = g;
+			algebra::scale(Real(-1), direction);
+			Real accepted = backtracking(f, x, f_x, g, direction, step, x_next, f_next);
+			if (accepted == Real(0)) break; //No further progress is possible
+			std::swap(x, x_next);
+			f_x = f_next;
+			g = gradient_of(f, x);
+			step = Real(2)*accepted;
+		}
+		return x;
+	}
+};
+
+GradientDescent gradient_descent(unsigned int iters = 1000, float tolerance = 1.e-5f, float step_size = 1.0f) {
+	return GradientDescent(iters, tolerance, step_size);
+}
+
+} // namespace opt
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "concepts.h"
+#include "dual.h"
+#include "tape.h"
+#include "autodiff.h"
+#include "algebra.h"
+#include "line-search.h"
+#include "derivative.h"
+#include "gradient-descent.h"
+#include "lbfgs.h"
+#include "minimize.h"
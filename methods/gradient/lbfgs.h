@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "concepts.h"
+#include "algebra.h"
+#include "line-search.h"
+#include "derivative.h"
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Limited memory BFGS: approximates the inverse of the Hessian from the last "memory" steps and gradient
+ * differences, and moves along the resulting quasi-Newton direction with a backtracking line search.
+ *
+ * Reference: Nocedal and Wright, Numerical Optimization (2nd ed.), algorithms 7.4 and 7.5.
+ **/
+class LBFGS
+{
+private:
+	unsigned int   iters_;			// maximum number of iterations
+	unsigned int   memory_;			// number of correction pairs kept
+	float          tolerance_;		// the method stops when all the components of the gradient are below this
+
+public:
+	LBFGS(unsigned int iters            = 1000,
+		unsigned int memory           = 8,
+		float tolerance               = 1.e-5f) :
+		iters_(iters),
+		memory_(std::max(1u, memory)),
+		tolerance_(tolerance) {}
+
+	/**
+	 * Minimizes f from ini. The logger receives, at each iteration, the step of the last line search, the 
+	 * position and its value (same interface as the pattern search loggers, see ../pattern-search/logger.h)
+	 **/
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 GradientFunction<FTarget, XType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(ini))>>;
+		XType x = ini;
+		YType f_x = f(x);
+		XType g = gradient_of(f, x);
+		XType direction = g, x_next = x, g_next = g;
+		YType f_next;
+
+		//Correction pairs in a ring buffer: s = x_next - x, y = g_next - g, rho = 1/(s . y)
+		std::vector<XType> s(memory_, x), y(memory_, x);
+		XType s_new = x, y_new = x;
+		std::vector<Real>  rho(memory_), alpha(memory_);
+		unsigned int stored = 0, newest = 0;
+		Real step = Real(0);
+
+		for (unsigned int i = 1; (i <= iters_) && (algebra::max_norm(g) > Real(tolerance_)); ++i) {
+			logger.log(i, step, x, f_x);
+			//Two loop recursion: direction = -H*g
+			direction = g;
+			for (unsigned int k = 0; k < stored; ++k) {
+				unsigned int j = (newest + memory_ - k) % memory_;
+				alpha[j] = rho[j]*algebra::dot(s[j], direction);
+				algebra::axpy(-alpha[j], y[j], direction);
+			}
+			if (stored > 0) algebra::scale(algebra::dot(s[newest], y[newest])/algebra::dot(y[newest], y[newest]), direction);
+			for (unsigned int k = stored; k > 0; --k) {
+				unsigned int j = (newest + memory_ + 1 - k) % memory_;
+				Real beta = rho[j]*algebra::dot(y[j], direction);
+				algebra::axpy(alpha[j] - beta, s[j], direction);
+			}
+			algebra::scale(Real(-1), direction);
+
+			//Without curvature information the first step is scaled to a unit move
+			Real initial = (stored > 0)?Real(1):std::min(Real(1), Real(1)/algebra::norm(g));
+			step = (algebra::dot(g, direction) < Real(0))?backtracking(f, x, f_x, g, direction, initial, x_next, f_next):Real(0);
+			if (step == Real(0)) {
+				if (stored == 0) break; //Not even steepest descent progresses
+				stored = 0;             //Forget the curvature information and try again with steepest descent
+				continue;
+			}
+
+			g_next = gradient_of(f, x_next);
+			algebra::difference(x_next, x, s_new);
+			algebra::difference(g_next, g, y_new);
+			Real sy = algebra::dot(s_new, y_new);
+			//Only pairs with positive curvature keep the approximation positive definite
+			if (sy > Real(1.e-10)*algebra::dot(y_new, y_new)) {
+				newest = (stored > 0)?((newest + 1) % memory_):0;
+				std::swap(s[newest], s_new);
+				std::swap(y[newest], y_new);
+				rho[newest] = Real(1)/sy;
+				stored = std::min(stored + 1, memory_);
+			}
+			std::swap(x, x_next);
+			std::swap(g, g_next);
+			f_x = f_next;
+		}
+		return x;
+	}
+};
+
+LBFGS lbfgs(unsigned int iters = 1000, unsigned int memory = 8, float tolerance = 1.e-5f) {
+	return LBFGS(iters, memory, tolerance);
+}
+
+} // namespace opt
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "algebra.h"
+
+namespace opt {
+
+/**
+ * Backtracking line search along a descent direction: starting with the given step, it is shrunk until
+ * the sufficient decrease (Armijo) condition f(x + step*direction) <= f(x) + c1*step*(gradient . direction)
+ * holds. On success, x_next and f_next hold the new position and its value and the accepted step is 
+ * returned. If no step is accepted after max_trials, it returns 0 (and x_next and f_next are meaningless).
+ **/
+template<typename XType, typename FTarget, typename YType, typename Real>
+Real backtracking(const FTarget& f, const XType& x, const YType& f_x, const XType& gradient, const XType& direction, Real step,
+                  XType& x_next, YType& f_next, Real c1 = Real(1.e-4), Real shrink = Real(0.5), unsigned int max_trials = 60) {
+	Real slope = algebra::dot(gradient, direction);
+	for (unsigned int trial = 0; trial < max_trials; ++trial, step *= shrink) {
+		x_next = x;
+		algebra::axpy(step, direction, x_next);
+		f_next = f(x_next);
+		if (f_next <= f_x + c1*step*slope) return step;
+	}
+	return Real(0);
+}
+
+} // namespace opt
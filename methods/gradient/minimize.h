@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "../../utils/tuple-array.h"
+#include "../pattern-search/logger.h"
+#include "concepts.h"
+#include "autodiff.h"
+
+namespace opt {
+
+namespace detail {
+	//Differentiable function of a tuple seen as a function of an array (all the elements of the tuple have the same type)
+	template<typename F>
+	class tuple_as_array {
+		const F& f;
+	public:
+		tuple_as_array(const F& f) : f(f) { }
+		template<typename ArrayType>
+		auto operator()(const ArrayType& x) const { return f(array_to_tuple(x)); }
+		template<typename ArrayType>
+		ArrayType gradient(const ArrayType& x) const { return tuple_to_array(f.gradient(array_to_tuple(x))); }
+	};
+}
+
+/*************************************
+ * Default calls strategies *
+ *************************************/
+
+template<typename F, typename Method, typename XType>
+requires DifferentiableFunction<F,XType> && Container<XType> && GradientMethod<Method>
+XType minimize(const F& f, const Method& method, const XType& ini) {
+	auto logger = pattern_search_logger::null();
+	return method.minimize(ini, f, logger);
+}
+
+template<typename F, typename Method,
+	typename XType = typename std::remove_cv_t<typename std::remove_reference_t<typename callable_traits<F>::template argument_type<0>>>>
+requires DifferentiableFunction<F,XType> && Container<XType> && GradientMethod<Method>
+XType minimize(const F& f, const Method& method) {
+	return minimize(f, method, XType());
+}
+
+template<typename F, typename Method,
+	typename XType = typename std::remove_cv_t<typename std::remove_reference_t<typename callable_traits<F>::template argument_type<0>>>>
+requires DifferentiableFunction<F,XType> && Tuple<XType> && (!Container<XType>) && GradientMethod<Method>
+XType minimize(const F& f, const Method& method) {
+	auto logger = pattern_search_logger::null();
+	return array_to_tuple(method.minimize(tuple_to_array(XType()), detail::tuple_as_array<F>(f), logger));
+}
+
+}; // namespace opt
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <iostream>
+
+namespace opt {
+
+/**
+ * Record of the operations of a reverse mode automatic differentiation. Each node stores the (at most two)
+ * nodes it depends on and the partial derivatives with respect to them, so that the gradient of the last
+ * result with respect to all the inputs is computed in a single backwards sweep, whatever the dimension.
+ * There is one tape per thread and per scalar type, reused (without reallocation) between evaluations.
+ **/
+template<typename Real>
+class tape {
+	struct node {
+		std::size_t parent[2];
+		Real        partial[2];
+	};
+	std::vector<node> nodes;
+	std::vector<Real> adjoint;
+public:
+	static tape& current() {
+		thread_local tape t;
+		return t;
+	}
+
+	void clear() { nodes.clear(); }
+	std::size_t size() const { return nodes.size(); }
+
+	//Independent variable (or constant): it depends on nothing
+	std::size_t push() { return push(0, Real(0), 0, Real(0)); }
+	std::size_t push(std::size_t p, Real dp) { return push(p, dp, 0, Real(0)); }
+	std::size_t push(std::size_t p0, Real d0, std::size_t p1, Real d1) {
+		nodes.push_back(node{{p0, p1}, {d0, d1}});
+		return nodes.size() - 1;
+	}
+
+	/**
+	 * Derivatives of the node "output" with respect to all the previous nodes (the first ones being, usually, the
+	 * inputs). The returned vector is owned by the tape and valid until the next call.
+	 **/
+	const std::vector<Real>& adjoints(std::size_t output) {
+		adjoint.assign(nodes.size(), Real(0));
+		adjoint[output] = Real(1);
+		for (std::size_t i = output + 1; i-- > 0; ) {
+			Real a = adjoint[i];
+			if (a == Real(0)) continue;
+			const node& n = nodes[i];
+			adjoint[n.parent[0]] += a*n.partial[0];
+			adjoint[n.parent[1]] += a*n.partial[1];
+		}
+		return adjoint;
+	}
+};
+
+/**
+ * Scalar for reverse mode automatic differentiation: its value and its position in the tape of the current
+ * thread. As with dual numbers, generic code must call math functions unqualified (sin(x), not std::sin(x)).
+ **/
+template<typename Real>
+class var {
+	Real        value_;
+	std::size_t index_;
+
+	var(Real value, std::size_t index) : value_(value), index_(index) { }
+	static var unary(Real value, const var& a, Real da) {
+		return var(value, tape<Real>::current().push(a.index_, da));
+	}
+	static var binary(Real value, const var& a, Real da, const var& b, Real db) {
+		return var(value, tape<Real>::current().push(a.index_, da, b.index_, db));
+	}
+public:
+	using value_type = Real;
+
+	var(Real value = Real(0)) : value_(value), index_(tape<Real>::current().push()) { }
+
+	Real value() const { return value_; }
+	std::size_t index() const { return index_; }
+	explicit operator Real() const { return value_; }
+
+	var& operator+=(const var& that) { return (*this) = (*this) + that; }
+	var& operator-=(const var& that) { return (*this) = (*this) - that; }
+	var& operator*=(const var& that) { return (*this) = (*this)*that; }
+	var& operator/=(const var& that) { return (*this) = (*this)/that; }
+
+	friend var operator-(const var& a) { return unary(-a.value_, a, Real(-1)); }
+	friend var operator+(const var& a) { return a; }
+	friend var operator+(const var& a, const var& b) { return binary(a.value_ + b.value_, a, Real(1), b, Real(1)); }
+	friend var operator-(const var& a, const var& b) { return binary(a.value_ - b.value_, a, Real(1), b, Real(-1)); }
+	friend var operator*(const var& a, const var& b) { return binary(a.value_*b.value_, a, b.value_, b, a.value_); }
+	friend var operator/(const var& a, const var& b) {
+		return binary(a.value_/b.value_, a, Real(1)/b.value_, b, -a.value_/(b.value_*b.value_)); }
+
+	friend bool operator< (const var& a, const var& b) { return a.value_ <  b.value_; }
+	friend bool operator> (const var& a, const var& b) { return a.value_ >  b.value_; }
+	friend bool operator<=(const var& a, const var& b) { return a.value_ <= b.value_; }
+	friend bool operator>=(const var& a, const var& b) { return a.value_ >= b.value_; }
+	friend bool operator==(const var& a, const var& b) { return a.value_ == b.value_; }
+	friend bool operator!=(const var& a, const var& b) { return a.value_ != b.value_; }
+
+	friend var sin(const var& a)  { return unary(std::sin(a.value_), a, std::cos(a.value_)); }
+	friend var cos(const var& a)  { return unary(std::cos(a.value_), a, -std::sin(a.value_)); }
+	friend var tan(const var& a)  { Real t = std::tan(a.value_); return unary(t, a, Real(1) + t*t); }
+	friend var exp(const var& a)  { Real e = std::exp(a.value_); return unary(e, a, e); }
+	friend var log(const var& a)  { return unary(std::log(a.value_), a, Real(1)/a.value_); }
+	friend var sqrt(const var& a) { Real s = std::sqrt(a.value_); return unary(s, a, Real(1)/(Real(2)*s)); }
+	friend var tanh(const var& a) { Real t = std::tanh(a.value_); return unary(t, a, Real(1) - t*t); }
+	friend var atan(const var& a) { return unary(std::atan(a.value_), a, Real(1)/(Real(1) + a.value_*a.value_)); }
+	friend var abs(const var& a)  { return unary(std::abs(a.value_), a, (a.value_ < Real(0))?Real(-1):Real(1)); }
+	friend var fabs(const var& a) { return abs(a); }
+	friend var pow(const var& a, Real p) {
+		return unary(std::pow(a.value_, p), a, p*std::pow(a.value_, p - Real(1))); }
+	friend var pow(const var& a, const var& b) {
+		Real v = std::pow(a.value_, b.value_);
+		return binary(v, a, b.value_*std::pow(a.value_, b.value_ - Real(1)), b, v*std::log(a.value_)); }
+
+	//Mixed operations with plain numbers do not record the number in the tape
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator+(const var& a, S b) { return unary(a.value_ + Real(b), a, Real(1)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator+(S a, const var& b) { return unary(Real(a) + b.value_, b, Real(1)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator-(const var& a, S b) { return unary(a.value_ - Real(b), a, Real(1)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator-(S a, const var& b) { return unary(Real(a) - b.value_, b, Real(-1)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator*(const var& a, S b) { return unary(a.value_*Real(b), a, Real(b)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator*(S a, const var& b) { return unary(Real(a)*b.value_, b, Real(a)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator/(const var& a, S b) { return unary(a.value_/Real(b), a, Real(1)/Real(b)); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend var operator/(S a, const var& b) { return unary(Real(a)/b.value_, b, -Real(a)/(b.value_*b.value_)); }
+
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend bool operator<(const var& a, S b) { return a.value_ < Real(b); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend bool operator<(S a, const var& b) { return Real(a) < b.value_; }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend bool operator>(const var& a, S b) { return a.value_ > Real(b); }
+	template<typename S> requires std::is_arithmetic_v<S>
+	friend bool operator>(S a, const var& b) { return Real(a) > b.value_; }
+
+	friend std::ostream& operator<<(std::ostream& os, const var& a) { return os<<a.value_; }
+};
+
+} // namespace opt
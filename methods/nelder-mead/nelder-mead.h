@@ -0,0 +1,185 @@
+#pragma once
+
+#include "../../utils/concepts.h"
+#include "../../utils/stopping.h"
+#include "../pattern-search/logger.h"
+#include "../pattern-search/concepts.h"
+#include <type_traits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Nelder-Mead simplex method: keeps n+1 positions in n dimensions and, at each iteration, replaces the worst
+ * of them by its reflection through the centroid of the others (expanded or contracted depending on how good
+ * the reflection is). Most iterations need one or two evaluations, instead of the 2n of a pattern search poll,
+ * so it suits expensive functions in moderate dimension. If nothing improves, the simplex shrinks towards
+ * its best position (n evaluations).
+ *
+ * The coefficients of the reflection, expansion, contraction and shrink are adaptive by default, which keeps
+ * the simplex from degenerating in high dimension. In one dimension the adaptive shrink would be 0, so the
+ * standard coefficients are used instead.
+ *
+ * References: J. A. Nelder and R. Mead, A simplex method for function minimization (1965); F. Gao and L. Han,
+ * Implementing the Nelder-Mead simplex algorithm with adaptive parameters (2012).
+ **/
+class NelderMead
+{
+private:
+	unsigned int   iters_;			// number of iterations
+	float          step_size_;		// Size of the initial simplex
+	float          epsilon_;		// Minimum size of the simplex
+	bool           adaptive_;		// coefficients that depend on the dimension instead of the standard ones
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h, except diversity)
+
+public:
+	NelderMead(unsigned int iters       = 1000,
+		float step_size               = 1.0f,
+		float epsilon                 = 1.e-6f,
+		bool adaptive                 = true,
+		const stopping& stop          = stopping()) :
+		iters_(iters),
+		step_size_(step_size),
+		epsilon_(epsilon),
+		adaptive_(adaptive),
+		stop_(stop) {}
+
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 TargetFunction<FTarget, XType, YType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		return minimize(ini, f, logger, [] (const YType&) { return false; });
+	}
+
+	/**
+	 * The initial simplex is ini and the n positions at distance step_size along each axis. The method stops
+	 * when the simplex is smaller than epsilon along every axis, after the given number of iterations, or as soon
+	 * as stop(f_best) or the additional stopping criteria say so (checked at the beginning of each iteration). The logger receives the size of
+	 * the simplex as step (same interface as pattern search, see ../pattern-search/logger.h).
+	 * The simplex is kept in double precision, and the positions are converted to XType for evaluating them.
+	 **/
+	template<typename XType, typename FTarget, typename Logger, typename FStop,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 TargetFunction<FTarget, XType, YType> &&
+	                 requires(const FStop& stop, const YType& y) { { stop(y) } -> bool; }
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger, const FStop& stop) const {
+		const std::size_t n = std::distance(std::begin(ini), std::end(ini));
+		if (n == 0) return ini;
+		const double N = double(n);
+		const bool   adaptive    = adaptive_ && (n >= 2);
+		const double reflection  = 1.0;
+		const double expansion   = adaptive?(1.0 + 2.0/N):2.0;
+		const double contraction = adaptive?(0.75 - 0.5/N):0.5;
+		const double shrink      = adaptive?(1.0 - 1.0/N):0.5;
+
+		//Vertices (one per row) and their values, nans are the worst
+		std::vector<double> simplex((n + 1)*n), centroid(n), xr(n), xe(n), xc(n);
+		std::vector<YType>  values(n + 1);
+		XType x = ini;
+		stopping::monitor monitor = stop_.start();
+		auto eval = [&x, &f, &monitor] (const std::vector<double>& p, std::size_t offset = 0) {
+			x_at(x, p, offset);
+			monitor.evaluated(1);
+			YType y = f(x);
+			return std::isnan(y)?std::numeric_limits<YType>::infinity():y;
+		};
+		{ std::size_t j = 0; for (auto v : ini) simplex[j++] = double(v); }
+		for (std::size_t i = 1; i <= n; ++i) {
+			std::copy(simplex.begin(), simplex.begin() + n, simplex.begin() + i*n);
+			simplex[i*n + i - 1] += double(step_size_);
+		}
+		for (std::size_t i = 0; i <= n; ++i) values[i] = eval(simplex, i*n);
+
+		std::size_t best = 0, worst = 0, second = 0;
+		auto order = [&] () {
+			best = 0; worst = 0;
+			for (std::size_t i = 1; i <= n; ++i) {
+				if (values[i] < values[best]) best = i;
+				if (values[i] >= values[worst]) worst = i;
+			}
+			second = best;
+			for (std::size_t i = 0; i <= n; ++i) if ((i != worst) && (values[i] >= values[second])) second = i;
+		};
+		auto size = [&] () {
+			double s = 0.0;
+			for (std::size_t i = 0; i <= n; ++i) for (std::size_t j = 0; j < n; ++j)
+				s = std::max(s, std::abs(simplex[i*n + j] - simplex[best*n + j]));
+			return s;
+		};
+		auto replace_worst = [&] (const std::vector<double>& p, YType y) {
+			std::copy(p.begin(), p.end(), simplex.begin() + worst*n);
+			values[worst] = y;
+		};
+
+		order();
+		double h = size();
+		for (unsigned int iter = 1; (iter <= iters_) && (h > double(epsilon_)) && !stop(values[best]) && !monitor.stop(); ++iter) {
+			x_at(x, simplex, best*n);
+			logger.log(iter, float(h), x, values[best]);
+
+			std::fill(centroid.begin(), centroid.end(), 0.0);
+			for (std::size_t i = 0; i <= n; ++i) if (i != worst)
+				for (std::size_t j = 0; j < n; ++j) centroid[j] += simplex[i*n + j]/N;
+
+			for (std::size_t j = 0; j < n; ++j) xr[j] = centroid[j] + reflection*(centroid[j] - simplex[worst*n + j]);
+			YType fr = eval(xr);
+			bool shrinking = false;
+			if (fr < values[best]) {
+				for (std::size_t j = 0; j < n; ++j) xe[j] = centroid[j] + expansion*(xr[j] - centroid[j]);
+				YType fe = eval(xe);
+				if (fe < fr) replace_worst(xe, fe);
+				else         replace_worst(xr, fr);
+			} else if (fr < values[second]) {
+				replace_worst(xr, fr);
+			} else if (fr < values[worst]) { //Outside contraction
+				for (std::size_t j = 0; j < n; ++j) xc[j] = centroid[j] + contraction*(xr[j] - centroid[j]);
+				YType fc = eval(xc);
+				if (fc <= fr) replace_worst(xc, fc);
+				else          shrinking = true;
+			} else {                         //Inside contraction
+				for (std::size_t j = 0; j < n; ++j) xc[j] = centroid[j] + contraction*(simplex[worst*n + j] - centroid[j]);
+				YType fc = eval(xc);
+				if (fc < values[worst]) replace_worst(xc, fc);
+				else                    shrinking = true;
+			}
+
+			if (shrinking) {
+				for (std::size_t i = 0; i <= n; ++i) if (i != best) {
+					for (std::size_t j = 0; j < n; ++j)
+						simplex[i*n + j] = simplex[best*n + j] + shrink*(simplex[i*n + j] - simplex[best*n + j]);
+					values[i] = eval(simplex, i*n);
+				}
+			}
+			order();
+			h = size();
+			monitor.iteration(values[best]);
+		}
+
+		x_at(x, simplex, best*n);
+		return x;
+	}
+
+private:
+	template<typename XType>
+	static void x_at(XType& x, const std::vector<double>& p, std::size_t offset) {
+		using Real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(x))>>;
+		for (auto xi = std::begin(x); xi != std::end(x); ++xi, ++offset) (*xi) = Real(p[offset]);
+	}
+};
+
+NelderMead nelder_mead(unsigned int iters = 1000, float step_size = 1.0f, float epsilon = 1.e-6f, bool adaptive = true,
+		const stopping& stop = stopping()) {
+	return NelderMead(iters, step_size, epsilon, adaptive, stop);
+}
+
+} // namespace opt
+
+#include "../pattern-search/minimize.h"
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "logger.h"
+#include <array>
+#include <functional>
+
+namespace opt {
+
+//Local search methods that, as PatternSearch, explore a real n-dimensional space from an initial position
+template <typename Method>
+concept bool PatternSearchMethod =
+    requires(const Method& m, std::function<float(const std::array<float,1>&)> target, const std::array<float,1>& init, 
+             pattern_search_logger::null& logger, std::array<float,1> sol) {
+	sol = m.minimize(init, target, logger); 
+    };
+
+} // namespace opt
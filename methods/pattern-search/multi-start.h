@@ -0,0 +1,115 @@
+#pragma once
+
+#include "pattern-search.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/philox.h"
+#include <vector>
+#include <random>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+#include <limits>
+
+namespace opt {
+
+/**
+ * Runs several independent pattern searches, each one from a different starting position, distributed
+ * among a pool of threads, and returns the best of their results.
+ *
+ * Runs are abandoned early when they are clearly dominated: when the best value they have found is
+ * above the best value found by any run so far by more than dominance*(1 + |global best|). As the
+ * global best can only decrease, the run that gives the final result is never abandoned, although an
+ * abandoned run might have ended up being better (a negative dominance disables this).
+ *
+ * The runs do not checkpoint their state, even if the local search has a checkpoint, as they would all
+ * share its file.
+ **/
+class PatternSearchMultiStart
+{
+private:
+	PatternSearch  local_;			// The pattern search run from each starting position (without checkpoint)
+	unsigned int   nstarts_;		// number of starting positions (when sampled)
+	float          radius_;			// starting positions are sampled in [ini - radius, ini + radius]
+	unsigned int   nthreads_;		// number of threads (0 = as many as the hardware supports)
+	float          dominance_;		// relative margin for abandoning runs (negative = never)
+	unsigned long  seed_;			// The seed for sampling the starting positions (random by default)
+
+public:
+	PatternSearchMultiStart(const PatternSearch& local = PatternSearch(),
+		unsigned int nstarts          = 8,
+		float radius                  = 1.0f,
+		unsigned int nthreads         = 0,
+		float dominance               = 1.0f,
+		unsigned long seed = (std::random_device())()) :
+		local_(local),
+		nstarts_(nstarts),
+		radius_(radius),
+		nthreads_(nthreads),
+		dominance_(dominance),
+		seed_(seed) { local_.checkpoint_ = checkpoint(); }
+
+	/**
+	 * Runs a pattern search from each of the starting positions. The logger receives the result of each
+	 * run once it finishes (with the index of the run as iteration), possibly from several threads but
+	 * never concurrently.
+	 **/
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 TargetFunction<FTarget, XType, YType>
+	XType minimize(const std::vector<XType>& starts, const FTarget& f, Logger& logger) const {
+		std::vector<XType> results(starts);
+		std::vector<YType> f_results(starts.size(), std::numeric_limits<YType>::infinity());
+		std::atomic<YType> global_best(std::numeric_limits<YType>::infinity());
+		std::mutex log_mutex;
+
+		thread_pool pool(nthreads_);
+		pool.parallel_for(starts.size(), [&] (std::size_t k) {
+			auto null = pattern_search_logger::null();
+			YType f_run = std::numeric_limits<YType>::infinity();
+			auto dominated = [&] (const YType& f_best) {
+				//Publish our best so far and check against the others (the last one is the value of the result)
+				f_run = f_best;
+				YType global = global_best.load();
+				while ((f_best < global) && !global_best.compare_exchange_weak(global, f_best)) { }
+				global = global_best.load();
+				return (dominance_ >= 0.0f) && ((f_best - global) > YType(dominance_)*(YType(1) + std::abs(global)));
+			};
+			results[k] = local_.minimize(starts[k], f, null, dominated);
+			f_results[k] = f_run;
+			std::lock_guard<std::mutex> lock(log_mutex);
+			logger.log(k, 0.0f, results[k], f_results[k]);
+		});
+
+		//The first of the best ones, so that ties do not depend on the threads
+		std::size_t best = 0;
+		for (std::size_t k = 1; k < results.size(); ++k)
+			if (f_results[k] < f_results[best]) best = k;
+		return results[best];
+	}
+
+	/**
+	 * Runs a pattern search from ini and from nstarts - 1 other positions sampled uniformly around it.
+	 **/
+	template<typename XType, typename FTarget, typename Logger,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 TargetFunction<FTarget, XType, YType>
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		using real = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(ini))>>;
+		philox random(seed_);
+		std::uniform_real_distribution<real> offset(-radius_, radius_);
+		std::vector<XType> starts(std::max(1u, nstarts_), ini);
+		for (std::size_t k = 1; k < starts.size(); ++k)
+			for (auto xi = std::begin(starts[k]); xi != std::end(starts[k]); ++xi) (*xi) += offset(random);
+		return minimize(starts, f, logger);
+	}
+};
+
+PatternSearchMultiStart multi_start(const PatternSearch& local = PatternSearch(), unsigned int nstarts = 8, float radius = 1.0f, unsigned int nthreads = 0, float dominance = 1.0f, unsigned long seed = (std::random_device())()) {
+	return PatternSearchMultiStart(local, nstarts, radius, nthreads, dominance, seed);
+}
+
+} // namespace opt
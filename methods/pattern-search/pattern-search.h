@@ -1,28 +1,95 @@
 #pragma once
 
 #include "../../utils/concepts.h"
+#include "../../utils/thread-pool.h"
+#include "../../utils/stopping.h"
+#include "../../utils/checkpoint.h"
+#include "concepts.h"
 #include <iostream>
 #include <type_traits>
 #include <array>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 
 namespace opt {
 
 
 class PatternSearch
 {
+	friend class PatternSearchMultiStart;
 private:
 	unsigned int   iters_;			// number of iterations
 	float          step_size_;		// Starting step size
 	float          epsilon_;        // Minimum step size
+	unsigned int   nthreads_;		// number of threads for evaluating the neighbours (1 = sequential)
+	bool           opportunistic_;	// accept the first improving neighbour instead of the best one
+	stopping       stop_;			// additional stopping criteria (see ../../utils/stopping.h)
+	checkpoint     checkpoint_;		// periodic saving of the state, and resuming from it (see ../../utils/checkpoint.h)
+
+	//The state after a number of polls: the best position, its value, the step size and the counters
+	template<typename XType, typename YType, typename H>
+	void save(const std::string& run, unsigned long polls, unsigned int i, const H& h, const XType& best, const YType& f_best, const stopping::monitor& monitor) const {
+		checkpoint::writer writer = checkpoint_.save("PatternSearch", run);
+		writer<<polls<<i<<h<<best<<f_best<<monitor.saved();
+		writer.commit();
+	}
 			
+	/**
+	 * Evaluates the 2*D neighbours of best (neighbour 2*i is best + h along dimension i, 2*i+1 is best - h)
+	 * on the pool and moves best to the one with the lowest value, if it improves. Ties are broken by 
+	 * the lowest index, which is what the sequential exploration does. If opportunistic, the neighbours are 
+	 * evaluated in blocks of the size of the pool and the search stops at the first block that improves,
+	 * taking the lowest value within that block (again, ties broken by the lowest index). Either way the
+	 * result does not depend on the thread timing, but the opportunistic one depends on the number of threads.
+	 * The number of evaluations is reported to the monitor.
+	 **/
+	template<typename XType, typename FTarget, typename YType, typename H>
+	bool poll(XType& best, YType& f_best, const H& h, const FTarget& f, thread_pool& pool,
+	          std::vector<XType>& neighbours, std::vector<YType>& f_neighbours, stopping::monitor& monitor) const {
+		std::size_t n = neighbours.size();
+		std::size_t block = opportunistic_?std::size_t(pool.size()):n;
+		for (std::size_t first = 0; first < n; first += block) {
+			std::size_t count = std::min(block, n - first);
+			pool.parallel_for(count, [&] (std::size_t j) {
+				XType& x = neighbours[first + j];
+				x = best;
+				auto xi = std::next(std::begin(x), (first + j)/2);
+				(*xi) += (((first + j)%2) == 0)?h:-h;
+				f_neighbours[first + j] = f(x);
+			});
+			monitor.evaluated(count);
+			std::size_t chosen = n;
+			for (std::size_t j = first; j < first + count; ++j)
+				if ((f_neighbours[j] < f_best) && ((chosen == n) || (f_neighbours[j] < f_neighbours[chosen]))) chosen = j;
+			if (chosen < n) {
+				best = neighbours[chosen]; f_best = f_neighbours[chosen];
+				return true;
+			}
+		}
+		return false;
+	}
 
 public:
+	/**
+	 * With nthreads > 1 the neighbours of each iteration are evaluated concurrently, so FTarget must be safe to 
+	 * call from several threads at once. The result is the same as the sequential one unless opportunistic, in which
+	 * case it depends on the number of threads (with nthreads = 0, on the number of cores of the machine).
+	 **/
 	PatternSearch(unsigned int iters    = 1000,
 		float step_size               = 1.0f,
-		float epsilon                 = 1.e-3f) :
+		float epsilon                 = 1.e-3f,
+		unsigned int nthreads         = 1,
+		bool opportunistic            = false,
+		const stopping& stop          = stopping(),
+		const checkpoint& checkpoints = checkpoint()) :
 		iters_(iters), 
 		step_size_(step_size),
-		epsilon_(epsilon) {}
+		epsilon_(epsilon),
+		nthreads_(nthreads),
+		opportunistic_(opportunistic),
+		stop_(stop),
+		checkpoint_(checkpoints) {}
 			
 	template<typename XType, typename FTarget, typename Logger,
 			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
@@ -30,20 +97,70 @@ public:
 	                 Container<XType> &&
 	                 TargetFunction<FTarget, XType, YType> 
 	XType minimize(const XType& ini, const FTarget& f, Logger& logger) const {
+		return minimize(ini, f, logger, [] (const YType&) { return false; });
+	}
+
+	/**
+	 * Same as above, but the search is abandoned (returning the best point found so far) as soon as 
+	 * stop(f_best) returns true, which is checked at the beginning of each iteration (as the additional 
+	 * stopping criteria of the method, for which each poll counts as an iteration). It is checked first, so
+	 * its last call always receives the value of the returned point.
+	 *
+	 * With a checkpoint, the state is saved every given number of polls and, if there is a checkpoint file
+	 * of a search with the same parameters and ini, the search continues from it instead of from ini. The file
+	 * is removed when the search finishes.
+	 **/
+	template<typename XType, typename FTarget, typename Logger, typename FStop,
+			typename YType = decltype(std::declval<FTarget>()(std::declval<XType>()))>
+    		requires std::is_floating_point_v<YType> &&
+	                 Container<XType> &&
+	                 TargetFunction<FTarget, XType, YType> &&
+	                 requires(const FStop& stop, const YType& y) { { stop(y) } -> bool; }
+	XType minimize(const XType& ini, const FTarget& f, Logger& logger, const FStop& stop) const {
+		stopping::monitor monitor = stop_.start();
+		checkpoint_.check<XType>();
+		//The opportunistic poll depends on the number of threads (see poll), so a different one is another run
+		const unsigned int block = opportunistic_?thread_pool::threads(nthreads_):0;
+		const std::string run_id = checkpoint_.identify(&ini, &ini + 1, iters_, step_size_, epsilon_, opportunistic_, block);
+		checkpoint::reader resumed = checkpoint_.load("PatternSearch", run_id);
 		XType best   = ini;
-		YType f_best = f(best);
-		decltype(std::begin(best)) besti;
+		YType f_best;
 		XType            x;
 		YType          f_x;
 		decltype(std::begin(x)) xi;
 
 		unsigned int  i = 1;
+		unsigned long polls = 0;
 		
 		//Now the algorithm works with the precision of the input data
 		typename std::remove_reference<decltype(*xi)>::type h   = step_size_; 
 		typename std::remove_reference<decltype(*xi)>::type eps = epsilon_; 
 
-		while ((eps < h) && (i <= iters_)) {
+		if (resumed) {
+			stopping::monitor::state state;
+			resumed>>polls>>i>>h>>best>>f_best>>state;
+			monitor.restore(state);
+		} else {
+			f_best = f(best);
+			monitor.evaluated(1);
+		}
+
+		if ((nthreads_ != 1) || opportunistic_) {
+			thread_pool pool(nthreads_);
+			std::vector<XType> neighbours(2*std::distance(std::begin(best), std::end(best)), best);
+			std::vector<YType> f_neighbours(neighbours.size());
+			while (!stop(f_best) && (eps < h) && (i <= iters_) && !monitor.stop()) {
+				logger.log(i,h,best,f_best);
+				if (poll(best, f_best, h, f, pool, neighbours, f_neighbours, monitor)) ++i;
+				else                                                                   h*=0.5f;
+				monitor.iteration(f_best);
+				if (checkpoint_.due(++polls)) save(run_id, polls, i, h, best, f_best, monitor);
+			}
+			checkpoint_.finish();
+			return best;
+		}
+
+		while (!stop(f_best) && (eps < h) && (i <= iters_) && !monitor.stop()) {
 			logger.log(i,h,best,f_best);
 			//First we explore the best "neighbour".
 			//This could be done in a more efficient way by avoiding the copy of XTypes and
@@ -66,18 +183,24 @@ public:
 
 			if (has_changed) ++i; 
 			else             h*=0.5f;
+			monitor.evaluated(2*std::distance(std::begin(x), std::end(x)));
+			monitor.iteration(f_best);
+			if (checkpoint_.due(++polls)) save(run_id, polls, i, h, best, f_best, monitor);
 		}
 
+		checkpoint_.finish();
 		return best;
 	}
 };
 
-PatternSearch pattern_search(unsigned int iters = 1000, float step_size = 1.0f, float epsilon = 1.e-6f) {
-	return PatternSearch(iters, step_size, epsilon);
+PatternSearch pattern_search(unsigned int iters = 1000, float step_size = 1.0f, float epsilon = 1.e-6f, unsigned int threads = 1, bool opportunistic = false,
+		const stopping& stop = stopping(), const checkpoint& checkpoints = checkpoint()) {
+	return PatternSearch(iters, step_size, epsilon, threads, opportunistic, stop, checkpoints);
 }
 
 
 } // namespace opt
 
 
+#include "multi-start.h"
 #include "minimize.h"
@@ -1,18 +1,37 @@
 #pragma once
 
 #include "methods/genetic/genetic.h"
+#include "methods/gradient/gradient.h"
 #include "utils/callable-tuple.h"
 
 namespace opt {
 
+template<typename F>
+concept bool SingleParameterFunction = (callable_traits<F>::argc == 1);
+
 template<typename F,
 	typename XType = typename std::remove_cv_t<typename std::remove_reference_t<typename callable_traits<F>::template argument_type<0>>>,
 	typename YType = decltype(std::declval<F>()(std::declval<XType>()))>
-requires callable_traits<F>::argc == 1 
+requires SingleParameterFunction<F>
 XType minimize(const F& f) {
 	return minimize(f, genetic());
 }
 
+//Functions that provide their gradient are minimized with L-BFGS by default
+template<typename F,
+	typename XType = typename std::remove_cv_t<typename std::remove_reference_t<typename callable_traits<F>::template argument_type<0>>>,
+	typename YType = decltype(std::declval<F>()(std::declval<XType>()))>
+requires SingleParameterFunction<F> && DifferentiableFunction<F,XType> && Container<XType>
+XType minimize(const F& f) {
+	return minimize(f, lbfgs());
+}
+
+template<typename F, typename XType>
+requires DifferentiableFunction<F,XType> && Container<XType> && std::is_floating_point_v<typename XType::value_type>
+XType minimize(const F& f, const XType& ini) {
+	return minimize(f, lbfgs(), ini);
+}
+
 template<typename F, typename... Args> 
 requires callable_traits<F>::argc > 1 
 auto minimize(const F& f, Args && ... args) {
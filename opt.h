@@ -2,4 +2,8 @@
 
 #include "methods/genetic/genetic.h"
 #include "methods/pattern-search/pattern-search.h"
+#include "methods/gradient/gradient.h"
+#include "methods/cma-es/cma-es.h"
+#include "methods/nelder-mead/nelder-mead.h"
+#include "methods/differential-evolution/differential-evolution.h"
 #include "minimize.h"
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <algorithm>
+
+namespace opt {
+
+/**
+ * Standard allocator whose blocks are aligned to Alignment bytes (a cache line by default), so that
+ * contiguous arrays of numbers can be processed with aligned SIMD loads.
+ **/
+template<typename T, std::size_t Alignment = 64>
+class aligned_allocator {
+	static constexpr std::size_t alignment = std::max(Alignment, alignof(T));
+public:
+	using value_type = T;
+	template<typename U> struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+	aligned_allocator() = default;
+	template<typename U>
+	aligned_allocator(const aligned_allocator<U, Alignment>&) { }
+
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(alignment)));
+	}
+	void deallocate(T* p, std::size_t n) {
+		::operator delete(p, std::align_val_t(alignment));
+	}
+
+	template<typename U>
+	bool operator==(const aligned_allocator<U, Alignment>&) const { return true; }
+	template<typename U>
+	bool operator!=(const aligned_allocator<U, Alignment>&) const { return false; }
+};
+
+} // namespace opt
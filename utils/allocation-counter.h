@@ -0,0 +1,46 @@
+#pragma once
+
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include "profile.h"
+
+/**
+ * Counts the dynamic memory allocations of the whole program by replacing the global operator new (and
+ * delete) with versions that increment opt::allocation_count, which profiling loggers report. As any
+ * replacement of operator new, it must be included in exactly one translation unit of the program
+ * (typically the one with main). Without it, opt::allocation_count stays at zero.
+ **/
+namespace opt {
+	namespace detail {
+		inline void* counted_allocation(std::size_t n, std::size_t alignment = 0) {
+			allocation_count.fetch_add(1, std::memory_order_relaxed);
+			if (n == 0) n = 1;
+			if (alignment > alignof(std::max_align_t)) return std::aligned_alloc(alignment, ((n + alignment - 1)/alignment)*alignment);
+			return std::malloc(n);
+		}
+		inline void* checked(void* p) { if (!p) throw std::bad_alloc(); return p; }
+	}
+}
+
+void* operator new(std::size_t n) { return opt::detail::checked(opt::detail::counted_allocation(n)); }
+void* operator new[](std::size_t n) { return opt::detail::checked(opt::detail::counted_allocation(n)); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return opt::detail::counted_allocation(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return opt::detail::counted_allocation(n); }
+void* operator new(std::size_t n, std::align_val_t a) { return opt::detail::checked(opt::detail::counted_allocation(n, std::size_t(a))); }
+void* operator new[](std::size_t n, std::align_val_t a) { return opt::detail::checked(opt::detail::counted_allocation(n, std::size_t(a))); }
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return opt::detail::counted_allocation(n, std::size_t(a)); }
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { return opt::detail::counted_allocation(n, std::size_t(a)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <random>
+#include <type_traits>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include "philox.h"
+
+namespace opt {
+
+/**
+ * Periodic saving of the state of a method (random number generator, population or current position, step
+ * size, counters...) into a file, from which a later call to the same method resumes. Long optimizations can
+ * then survive being killed: they are run again with the same checkpoint and continue from the last save.
+ * - path: the file. It is written as path.tmp and then renamed, so it is never left half written.
+ * - every: iterations between saves (0 disables checkpointing).
+ * - resume: whether to start from the file if it exists (otherwise it is overwritten).
+ *
+ * The state of the function to minimize and of the mutation and crossover operators (as the step size of
+ * adaptive mutations) is not saved. Genomes are saved as raw bytes if they are trivially copyable (as
+ * std::array<float,N>), element by element if they are std::vector, std::array, std::pair or std::tuple, and
+ * otherwise with their operators << and >>. Checkpointing a method whose genomes are none of these throws
+ * std::logic_error. Checkpoints are only readable by the same program on the same kind of machine.
+ *
+ * A checkpoint identifies the run that wrote it (the parameters of the method and a digest of its initial
+ * population or position), and resuming from the checkpoint of another run throws std::runtime_error. The file
+ * is removed when the method finishes, so running the same program again starts from the beginning.
+ *
+ * The checkpoint is the last parameter of the constructors of the methods that support it, for instance
+ * opt::pattern_search(1000, 1.0f, 1.e-6f, 1, false, opt::stopping(), opt::checkpoint("run.checkpoint", 100)).
+ **/
+class checkpoint {
+	std::string   path_;
+	unsigned long every_;
+	bool          resume_;
+
+public:
+	checkpoint(const std::string& path = std::string(), unsigned long every = 100, bool resume = true) :
+		path_(path), every_(every), resume_(resume) { }
+
+	bool enabled() const { return (!path_.empty()) && (every_ > 0); }
+	//Whether the state should be saved after the given iteration
+	bool due(unsigned long iteration) const { return enabled() && ((iteration % every_) == 0); }
+	const std::string& path() const { return path_; }
+	unsigned long every() const { return every_; }
+
+	//Throws std::logic_error if checkpointing is enabled but T cannot be saved (before the method starts)
+	template<typename T>
+	void check() const;
+
+	//Identification of a run from the initial population (or position) in [begin, end) and the parameters of the
+	//method that change its result (empty if checkpointing is disabled)
+	template<typename Iterator, typename... Parameters>
+	std::string identify(const Iterator& begin, const Iterator& end, const Parameters&... parameters) const;
+
+	class writer;
+	class reader;
+	//Writer of a new checkpoint of the given method (a name that identifies it) and run (see identify), both
+	//checked when resuming
+	writer save(const std::string& method, const std::string& run) const;
+	//Reader of the last checkpoint of the method and run, which evaluates to false if there is none to resume from
+	reader load(const std::string& method, const std::string& run) const;
+	//Removes the checkpoint once the method has finished
+	void finish() const;
+};
+
+namespace checkpoint_format {
+	template<typename T>
+	concept bool Streamable = requires(std::ostream& os, std::istream& is, T& t) { os<<t; is>>t; };
+
+	template<typename T> struct is_sequence : std::false_type { };
+	template<typename T, typename A> struct is_sequence<std::vector<T,A>> : std::true_type { };
+	template<typename T, std::size_t N> struct is_sequence<std::array<T,N>> : std::true_type { };
+	template<typename T> struct is_tuple : std::false_type { };
+	template<typename... T> struct is_tuple<std::tuple<T...>> : std::true_type { };
+	template<typename A, typename B> struct is_tuple<std::pair<A,B>> : std::true_type { };
+	template<typename T> struct is_engine : std::false_type { };
+	template<typename U, std::size_t w, std::size_t n, std::size_t m, std::size_t r, U a, std::size_t u, U d, std::size_t s, U b, std::size_t t, U c, std::size_t l, U f>
+	struct is_engine<std::mersenne_twister_engine<U,w,n,m,r,a,u,d,s,b,t,c,l,f>> : std::true_type { };
+	template<> struct is_engine<philox> : std::true_type { };
+
+	//Whether T can be written and read back
+	template<typename T>
+	struct supported : std::bool_constant<is_engine<T>::value || std::is_trivially_copyable_v<T> || std::is_same_v<T, std::string> || Streamable<T>> { };
+	template<typename T, typename A>
+	struct supported<std::vector<T,A>> : supported<T> { };
+	template<typename T, std::size_t N>
+	struct supported<std::array<T,N>> : std::bool_constant<std::is_trivially_copyable_v<T> || supported<T>::value> { };
+	template<typename... T>
+	struct supported<std::tuple<T...>> : std::bool_constant<std::is_trivially_copyable_v<std::tuple<T...>> || (supported<T>::value && ... && true)> { };
+	template<typename A, typename B>
+	struct supported<std::pair<A,B>> : std::bool_constant<std::is_trivially_copyable_v<std::pair<A,B>> || (supported<A>::value && supported<B>::value)> { };
+
+	template<typename T>
+	void write(std::ostream& os, const T& t) {
+		if constexpr (is_engine<T>::value) { std::ostringstream s; s<<t; write(os, s.str()); } //Portable text representation
+		else if constexpr (std::is_same_v<T, std::string>) {
+			std::uint64_t n = t.size();
+			os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+			os.write(t.data(), std::streamsize(n));
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>) os.write(reinterpret_cast<const char*>(&t), sizeof(T));
+		else if constexpr (is_sequence<T>::value) {
+			std::uint64_t n = t.size();
+			os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+			for (const auto& e : t) write(os, e);
+		}
+		else if constexpr (is_tuple<T>::value) std::apply([&os] (const auto&... e) { (write(os, e), ...); }, t);
+		else if constexpr (Streamable<T>) { std::ostringstream s; s.precision(17); s<<t; write(os, s.str()); }
+		else throw std::logic_error("The genomes of this method cannot be checkpointed");
+	}
+
+	template<typename T>
+	void read(std::istream& is, T& t) {
+		if constexpr (is_engine<T>::value) { std::string s; read(is, s); std::istringstream(s)>>t; }
+		else if constexpr (std::is_same_v<T, std::string>) {
+			std::uint64_t n = 0;
+			is.read(reinterpret_cast<char*>(&n), sizeof(n));
+			if (!is) return;
+			t.resize(n);
+			is.read(&t[0], std::streamsize(n));
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>) is.read(reinterpret_cast<char*>(&t), sizeof(T));
+		else if constexpr (is_sequence<T>::value) {
+			std::uint64_t n = 0;
+			is.read(reinterpret_cast<char*>(&n), sizeof(n));
+			if constexpr (std::is_same_v<T, std::vector<typename T::value_type, typename T::allocator_type>>) { if (is) t.resize(n); }
+			for (auto& e : t) read(is, e);
+		}
+		else if constexpr (is_tuple<T>::value) std::apply([&is] (auto&... e) { (read(is, e), ...); }, t);
+		else if constexpr (Streamable<T>) { std::string s; read(is, s); std::istringstream(s)>>t; }
+		else throw std::logic_error("The genomes of this method cannot be checkpointed");
+	}
+}
+
+class checkpoint::writer {
+	std::ofstream os;
+	std::string   path, temporary;
+public:
+	writer(const std::string& path, const std::string& method, const std::string& run) :
+		os(path + ".tmp", std::ios::binary | std::ios::trunc), path(path), temporary(path + ".tmp") {
+		if (!os) throw std::runtime_error("Cannot write checkpoint " + temporary);
+		os.write("OPTCKPT3", 8);
+		checkpoint_format::write(os, method);
+		checkpoint_format::write(os, run);
+	}
+
+	template<typename T>
+	writer& operator<<(const T& t) { checkpoint_format::write(os, t); return *this; }
+
+	//Replaces the previous checkpoint by the one written
+	void commit() {
+		os.close();
+		if (!os) throw std::runtime_error("Cannot write checkpoint " + temporary);
+		if (std::rename(temporary.c_str(), path.c_str()) != 0) throw std::runtime_error("Cannot replace checkpoint " + path);
+	}
+};
+
+class checkpoint::reader {
+	std::ifstream is;
+public:
+	reader() { }
+	reader(const std::string& path, const std::string& method, const std::string& run) : is(path, std::ios::binary) {
+		if (!is) return; //Nothing to resume from
+		char magic[8];
+		std::string saved, saved_run;
+		is.read(magic, 8);
+		if (is) checkpoint_format::read(is, saved);
+		if (is) checkpoint_format::read(is, saved_run);
+		if (!is || (std::memcmp(magic, "OPTCKPT3", 8) != 0)) throw std::runtime_error(path + " is not a checkpoint");
+		if (saved != method) throw std::runtime_error(path + " is a checkpoint of " + saved + ", not of " + method);
+		if (saved_run != run) throw std::runtime_error(path + " is a checkpoint of another run of " + method + " (with other parameters or initial population)");
+	}
+
+	explicit operator bool() const { return is.is_open() && bool(is); }
+
+	template<typename T>
+	reader& operator>>(T& t) {
+		checkpoint_format::read(is, t);
+		if (!is) throw std::runtime_error("Truncated checkpoint");
+		return *this;
+	}
+};
+
+template<typename T>
+void checkpoint::check() const {
+	if (enabled() && !checkpoint_format::supported<T>::value) throw std::logic_error("The genomes of this method cannot be checkpointed");
+}
+
+template<typename Iterator, typename... Parameters>
+std::string checkpoint::identify(const Iterator& begin, const Iterator& end, const Parameters&... parameters) const {
+	if (!enabled()) return std::string();
+	using XType = std::decay_t<decltype(*begin)>;
+	std::ostringstream genomes(std::ios::binary);
+	for (Iterator i = begin; i != end; ++i) checkpoint_format::write(genomes, *i);
+	std::uint64_t digest = 14695981039346656037ull; //FNV-1a
+	for (char c : genomes.str()) { digest ^= std::uint8_t(c); digest *= 1099511628211ull; }
+	std::ostringstream run;
+	run.precision(17);
+	run<<"genome="<<sizeof(XType)<<" individuals="<<std::distance(begin, end)<<" digest="<<std::hex<<digest<<std::dec<<" parameters=";
+	((run<<parameters<<' '), ...);
+	return run.str();
+}
+
+inline checkpoint::writer checkpoint::save(const std::string& method, const std::string& run) const { return writer(path_, method, run); }
+inline checkpoint::reader checkpoint::load(const std::string& method, const std::string& run) const {
+	if (!enabled() || !resume_) return reader();
+	return reader(path_, method, run);
+}
+inline void checkpoint::finish() const { if (enabled()) std::remove(path_.c_str()); }
+
+} // namespace opt
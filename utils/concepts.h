@@ -1,6 +1,7 @@
 #pragma once
 
 #include <type_traits>
+#include <tuple>
 
 template <typename RNG>
 concept bool UniformRandomBitGenerator = 
@@ -41,3 +42,9 @@ concept bool Tuple =
    };
 
 
+template <typename T>
+concept bool LessThanComparable =
+   requires (const T& a, const T& b) {
+      { a < b } -> bool;
+   };
+
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "span.h"
+#include "genome-hash.h"
+#include <callable/callable.hpp>
+#include <functional>
+#include <unordered_map>
+#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+
+namespace opt {
+
+namespace detail {
+	//Cache and counters shared by the scalar and batch fitness caches (see fitness_cache below)
+	template<typename XType, typename F, typename YType, typename Hash>
+	class fitness_cache_base {
+		using Entry = std::pair<XType, YType>;
+		struct State {
+			std::mutex mutex;
+			std::list<Entry> entries; //Most recently used first
+			std::unordered_map<XType, typename std::list<Entry>::iterator, Hash> index;
+			unsigned long hits = 0, misses = 0;
+		};
+
+	protected:
+		F f;
+		std::size_t capacity_;
+		std::shared_ptr<State> state;
+
+		//Looks up x, moving it to the front. Must be called with the lock held
+		bool find(const XType& x, YType& y) const {
+			auto found = state->index.find(x);
+			if (found == state->index.end()) { ++state->misses; return false; }
+			++state->hits;
+			state->entries.splice(state->entries.begin(), state->entries, found->second);
+			y = found->second->second;
+			return true;
+		}
+
+		//Must be called with the lock held
+		void insert(const XType& x, const YType& y) const {
+			if ((capacity_ == 0) || (state->index.find(x) != state->index.end())) return;
+			if (state->entries.size() >= capacity_) {
+				//Reuses the least recently used node
+				state->index.erase(state->entries.back().first);
+				state->entries.splice(state->entries.begin(), state->entries, std::prev(state->entries.end()));
+				state->entries.front() = Entry(x, y);
+			} else state->entries.emplace_front(x, y);
+			state->index.emplace(x, state->entries.begin());
+		}
+
+	public:
+		fitness_cache_base(const F& f, std::size_t capacity) : f(f), capacity_(capacity), state(std::make_shared<State>()) {
+			state->index.reserve(std::min<std::size_t>(capacity, 1<<16));
+		}
+
+		unsigned long hits() const   { std::lock_guard<std::mutex> lock(state->mutex); return state->hits; }
+		unsigned long misses() const { std::lock_guard<std::mutex> lock(state->mutex); return state->misses; }
+		std::size_t size() const     { std::lock_guard<std::mutex> lock(state->mutex); return state->entries.size(); }
+		std::size_t capacity() const { return capacity_; }
+
+		void clear() {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->entries.clear(); state->index.clear();
+			state->hits = state->misses = 0;
+		}
+	};
+}
+
+/**
+ * Wraps a function to minimize and remembers the value of the last evaluated elements (up to capacity, discarding
+ * the least recently used ones), so that repeated elements (which crossovers and bit mutations regenerate often)
+ * cost a hash lookup instead of an evaluation. It can be used as the function to minimize of any method.
+ *
+ * Copies share the same cache and counters, and it is safe to call concurrently (the evaluations themselves run
+ * outside the lock). If F is a batch function (see BatchTargetFunction), only the elements not found in the
+ * cache are passed to it, in a single call.
+ **/
+template<typename XType, typename F, typename YType = float, typename Hash = genome_hash<XType>>
+class fitness_cache : public detail::fitness_cache_base<XType, F, YType, Hash> {
+	using Base = detail::fitness_cache_base<XType, F, YType, Hash>;
+public:
+	fitness_cache(const F& f, std::size_t capacity = 1000000) : Base(f, capacity) { }
+
+	//Not a template, so that the parameter type can be deduced from it (as opt::minimize does)
+	YType operator()(const XType& x) const {
+		YType y;
+		{
+			std::lock_guard<std::mutex> lock(this->state->mutex);
+			if (this->find(x, y)) return y;
+		}
+		y = this->f(x);
+		std::lock_guard<std::mutex> lock(this->state->mutex);
+		this->insert(x, y);
+		return y;
+	}
+};
+
+template<typename XType, typename F, typename YType, typename Hash>
+requires requires(const F& g, span<const XType> x, span<YType> y) { g(x, y); }
+class fitness_cache<XType, F, YType, Hash> : public detail::fitness_cache_base<XType, F, YType, Hash> {
+	using Base = detail::fitness_cache_base<XType, F, YType, Hash>;
+public:
+	fitness_cache(const F& f, std::size_t capacity = 1000000) : Base(f, capacity) { }
+
+	void operator()(span<const XType> x, span<YType> y) const {
+		std::vector<std::size_t> missing;
+		{
+			std::lock_guard<std::mutex> lock(this->state->mutex);
+			for (std::size_t i = 0; i < x.size(); ++i) if (!this->find(x[i], y[i])) missing.push_back(i);
+		}
+		if (missing.empty()) return;
+		std::vector<XType> xm; xm.reserve(missing.size());
+		for (std::size_t i : missing) xm.push_back(x[i]);
+		std::vector<YType> ym(missing.size());
+		this->f(span<const XType>(xm.data(), xm.size()), span<YType>(ym.data(), ym.size()));
+		std::lock_guard<std::mutex> lock(this->state->mutex);
+		for (std::size_t j = 0; j < missing.size(); ++j) { y[missing[j]] = ym[j]; this->insert(xm[j], ym[j]); }
+	}
+};
+
+/**
+ * Cache for a function with a single parameter, whose type is deduced
+ **/
+template<typename F,
+	typename XType = std::decay_t<typename callable_traits<F>::template argument_type<0>>,
+	typename YType = decltype(std::declval<F>()(std::declval<XType>()))>
+requires callable_traits<F>::argc == 1
+fitness_cache<XType, F, YType> cached(const F& f, std::size_t capacity = 1000000) {
+	return fitness_cache<XType, F, YType>(f, capacity);
+}
+
+} // namespace opt
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <iterator>
+
+namespace opt {
+
+/**
+ * Hash of a genome: std::hash when available, otherwise the combination of the hashes of the elements of
+ * containers (such as std::array or std::vector) and tuples.
+ **/
+template<typename X, typename Enable = void>
+struct genome_hash;
+
+namespace detail {
+	inline std::size_t hash_combine(std::size_t seed, std::size_t h) {
+		return seed ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+	template<typename X, typename = void>
+	struct has_std_hash : std::false_type { };
+	template<typename X>
+	struct has_std_hash<X, std::void_t<decltype(std::hash<X>()(std::declval<const X&>()))>> : std::true_type { };
+
+	template<typename X, typename = void>
+	struct is_iterable : std::false_type { };
+	template<typename X>
+	struct is_iterable<X, std::void_t<decltype(std::begin(std::declval<const X&>())), decltype(std::end(std::declval<const X&>()))>> : std::true_type { };
+}
+
+template<typename X>
+struct genome_hash<X, std::enable_if_t<detail::has_std_hash<X>::value>> {
+	std::size_t operator()(const X& x) const { return std::hash<X>()(x); }
+};
+
+template<typename X>
+struct genome_hash<X, std::enable_if_t<!detail::has_std_hash<X>::value && detail::is_iterable<X>::value>> {
+	std::size_t operator()(const X& x) const {
+		std::size_t seed = 0;
+		for (const auto& e : x) seed = detail::hash_combine(seed, genome_hash<std::decay_t<decltype(e)>>()(e));
+		return seed;
+	}
+};
+
+template<typename... Args>
+struct genome_hash<std::tuple<Args...>, std::enable_if_t<!detail::has_std_hash<std::tuple<Args...>>::value>> {
+	std::size_t operator()(const std::tuple<Args...>& x) const {
+		return std::apply([] (const Args&... e) {
+			std::size_t seed = 0;
+			((seed = detail::hash_combine(seed, genome_hash<Args>()(e))), ...);
+			return seed; }, x);
+	}
+};
+
+} // namespace opt
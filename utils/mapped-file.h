@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+#include <algorithm>
+#include <cstddef>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace opt {
+
+/**
+ * File that is written by appending bytes to a memory mapping of it (POSIX), so that writing is just copying
+ * into memory. The file grows (doubling its mapping) as needed, and is cut to the bytes actually written when
+ * closed. Errors when opening or growing the file throw std::system_error.
+ **/
+class mapped_file_writer {
+	int         fd       = -1;
+	char*       data_    = nullptr;
+	std::size_t size_    = 0;	//bytes written
+	std::size_t capacity = 0;	//bytes mapped
+
+	static std::system_error error(const std::string& what) { return std::system_error(errno, std::generic_category(), what); }
+
+	void map(std::size_t bytes) {
+		if (data_) munmap(data_, capacity);
+		data_ = nullptr;
+		if (ftruncate(fd, off_t(bytes)) != 0) throw error("Cannot grow mapped file");
+		void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) throw error("Cannot map file");
+		data_ = static_cast<char*>(p);
+		capacity = bytes;
+	}
+
+public:
+	mapped_file_writer(const std::string& path, std::size_t initial_capacity = std::size_t(1) << 20) {
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) throw error("Cannot open " + path);
+		try { map(std::max<std::size_t>(initial_capacity, 4096)); }
+		catch (...) { ::close(fd); throw; }
+	}
+	mapped_file_writer(const mapped_file_writer&) = delete;
+	mapped_file_writer& operator=(const mapped_file_writer&) = delete;
+	mapped_file_writer(mapped_file_writer&& that) :
+		fd(that.fd), data_(that.data_), size_(that.size_), capacity(that.capacity) {
+		that.fd = -1; that.data_ = nullptr;
+	}
+
+	~mapped_file_writer() {
+		if (data_) munmap(data_, capacity);
+		if (fd >= 0) {
+			if (ftruncate(fd, off_t(size_)) != 0) { } //Nothing to do, the file just keeps some unused bytes
+			::close(fd);
+		}
+	}
+
+	//Adds n bytes at the end of the file and returns where to write them. It invalidates the previous pointers.
+	char* extend(std::size_t n) {
+		if (size_ + n > capacity) map(std::max(2*capacity, size_ + n));
+		char* p = data_ + size_;
+		size_ += n;
+		return p;
+	}
+
+	char* data() { return data_; }
+	std::size_t size() const { return size_; }
+};
+
+/**
+ * Read-only memory mapping of a whole file. Errors when opening it throw std::system_error.
+ **/
+class mapped_file_reader {
+	int         fd    = -1;
+	const char* data_ = nullptr;
+	std::size_t size_ = 0;
+
+public:
+	mapped_file_reader(const std::string& path) {
+		fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+		struct stat s;
+		if (fstat(fd, &s) == 0) size_ = std::size_t(s.st_size);
+		if (size_ > 0) {
+			void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p == MAP_FAILED) { ::close(fd); throw std::system_error(errno, std::generic_category(), "Cannot map " + path); }
+			data_ = static_cast<const char*>(p);
+		}
+	}
+	mapped_file_reader(const mapped_file_reader&) = delete;
+	mapped_file_reader& operator=(const mapped_file_reader&) = delete;
+
+	~mapped_file_reader() {
+		if (data_) munmap(const_cast<char*>(data_), size_);
+		if (fd >= 0) ::close(fd);
+	}
+
+	const char* data() const { return data_; }
+	std::size_t size() const { return size_; }
+};
+
+} // namespace opt
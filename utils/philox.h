@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <istream>
+#include <ostream>
+
+namespace opt {
+
+/**
+ * Philox4x32-10 counter-based random number generator: the n-th block of four 32 bit numbers is a bijection
+ * (ten rounds of multiplications and xors keyed by the seed) of the counter n. Its state is a few words, it
+ * is constructed at no cost and any number of independent streams are obtained by putting the stream in the
+ * upper words of the counter, so each individual (or thread) of an iteration can draw from its own stream, as
+ * in philox(seed, iteration, individual), and the result does not depend on which thread runs it. The lower
+ * two words count the blocks, so each stream has 2^66 numbers before it cycles.
+ *
+ * It satisfies UniformRandomBitGenerator (and the standard random number engine interface except the
+ * constructors from a seed sequence), so it can be used with the distributions of <random>.
+ *
+ * Reference: J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, Parallel random numbers: as easy as 1, 2, 3 (2011).
+ **/
+class philox {
+public:
+	using result_type = std::uint32_t;
+	using counter_type = std::array<std::uint32_t, 4>;
+	using key_type = std::array<std::uint32_t, 2>;
+
+private:
+	key_type     key_;
+	counter_type counter_;		// next block: counter_[0..1] is the block within the stream, counter_[2..3] the stream
+	counter_type output_;		// current block
+	unsigned int used_;			// numbers of the current block already returned
+
+	static void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+		std::uint64_t p = std::uint64_t(a)*std::uint64_t(b);
+		hi = std::uint32_t(p >> 32); lo = std::uint32_t(p);
+	}
+
+	std::uint64_t block_index() const { return std::uint64_t(counter_[0]) | (std::uint64_t(counter_[1]) << 32); }
+	void block_index(std::uint64_t b) { counter_[0] = std::uint32_t(b); counter_[1] = std::uint32_t(b >> 32); }
+
+	void generate() {
+		output_ = block(counter_, key_);
+		block_index(block_index() + 1);
+		used_ = 0;
+	}
+
+public:
+	static constexpr result_type default_seed = 20111115u;
+
+	/**
+	 * Stream number (stream, substream) of the given seed. Different streams never overlap, and each one cycles
+	 * after 2^66 numbers.
+	 **/
+	explicit philox(std::uint64_t seed = default_seed, std::uint32_t stream = 0, std::uint32_t substream = 0) {
+		this->seed(seed, stream, substream);
+	}
+
+	void seed(std::uint64_t seed = default_seed, std::uint32_t stream = 0, std::uint32_t substream = 0) {
+		key_     = key_type{std::uint32_t(seed), std::uint32_t(seed >> 32)};
+		counter_ = counter_type{0, 0, substream, stream};
+		output_  = counter_type{0, 0, 0, 0};
+		used_    = 4;
+	}
+
+	//Another stream of the same seed
+	philox split(std::uint32_t stream, std::uint32_t substream = 0) const {
+		philox p(*this);
+		p.counter_ = counter_type{0, 0, substream, stream};
+		p.output_ = counter_type{0, 0, 0, 0};
+		p.used_ = 4;
+		return p;
+	}
+
+	//The Philox4x32-10 bijection
+	static counter_type block(counter_type c, key_type k) {
+		for (int round = 0; round < 10; ++round) {
+			if (round > 0) { k[0] += 0x9E3779B9u; k[1] += 0xBB67AE85u; }
+			std::uint32_t hi0, lo0, hi1, lo1;
+			mulhilo(0xD2511F53u, c[0], hi0, lo0);
+			mulhilo(0xCD9E8D57u, c[2], hi1, lo1);
+			c = counter_type{hi1 ^ c[1] ^ k[0], lo1, hi0 ^ c[3] ^ k[1], lo0};
+		}
+		return c;
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()() {
+		if (used_ == 4) generate();
+		return output_[used_++];
+	}
+
+	void discard(unsigned long long n) {
+		if (n < 4 - used_) { used_ += unsigned(n); return; }
+		n -= 4 - used_;
+		block_index(block_index() + n/4);
+		used_ = 4;
+		if ((n % 4) != 0) { generate(); used_ = unsigned(n % 4); }
+	}
+
+	friend bool operator==(const philox& a, const philox& b) {
+		return (a.key_ == b.key_) && (a.counter_ == b.counter_) && (a.used_ == b.used_) && ((a.used_ == 4) || (a.output_ == b.output_));
+	}
+	friend bool operator!=(const philox& a, const philox& b) { return !(a == b); }
+
+	template<typename CharT, typename Traits>
+	friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const philox& p) {
+		return os<<p.key_[0]<<' '<<p.key_[1]<<' '<<p.counter_[0]<<' '<<p.counter_[1]<<' '<<p.counter_[2]<<' '<<p.counter_[3]<<' '<<p.used_;
+	}
+
+	template<typename CharT, typename Traits>
+	friend std::basic_istream<CharT, Traits>& operator>>(std::basic_istream<CharT, Traits>& is, philox& p) {
+		philox q;
+		is>>q.key_[0]>>q.key_[1]>>q.counter_[0]>>q.counter_[1]>>q.counter_[2]>>q.counter_[3]>>q.used_;
+		if (!is) return is;
+		if (q.used_ < 4) { //The current block is the previous one
+			q.block_index(q.block_index() - 1);
+			unsigned int used = q.used_;
+			q.generate();
+			q.used_ = used;
+		} else q.used_ = 4;
+		p = q;
+		return is;
+	}
+};
+
+} // namespace opt
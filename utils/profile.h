@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <tuple>
+#include <limits>
+#include <cmath>
+
+namespace opt {
+
+//Number of dynamic memory allocations of the program, only counted if utils/allocation-counter.h is included
+inline std::atomic<unsigned long> allocation_count{0};
+
+/**
+ * What happened in one iteration (generation) of a genetic method: the time, in seconds, spent on each of its
+ * stages, the evaluations of the function and the memory allocations of the whole program (see
+ * utils/allocation-counter.h) during the iteration, and the best and mean values of the selected population.
+ **/
+struct generation_profile {
+	unsigned long iteration   = 0;
+	double        selection   = 0.0;
+	double        mutation    = 0.0;
+	double        crossover   = 0.0;
+	double        evaluation  = 0.0;
+	unsigned long evaluations = 0;
+	unsigned long allocations = 0;
+	double        best        = std::numeric_limits<double>::quiet_NaN();
+	double        mean        = std::numeric_limits<double>::quiet_NaN();
+};
+
+//Loggers that, besides the population, receive the profile of each iteration
+template<typename Logger>
+concept bool ProfilingLogger =
+    requires(Logger& logger, const generation_profile& profile) {
+	logger.profile(profile);
+    };
+
+/**
+ * Measures the profile of each iteration for the engines. It does nothing (and costs nothing) unless
+ * Enabled, which the engines set when their logger is a ProfilingLogger:
+ *
+ *    profiler<ProfilingLogger<Logger>> profiler;
+ *    profiler.begin(iteration);
+ *    { auto timing = profiler.stage(&generation_profile::mutation); ... }
+ *    profiler.evaluated(n);
+ *    profiler.end(logger, population_begin, population_end);
+ **/
+template<bool Enabled>
+class profiler {
+public:
+	struct scope { ~scope() { } }; //Not trivial, so that unused scopes do not raise warnings
+	void begin(unsigned long iteration) { }
+	scope stage(double generation_profile::* s) { return scope(); }
+	void evaluated(unsigned long n) { }
+	template<typename Logger, typename Iterator>
+	void end(Logger& logger, const Iterator& begin, const Iterator& end) { }
+};
+
+template<>
+class profiler<true> {
+	generation_profile current;
+	unsigned long      allocations;
+public:
+	//Adds the time from its construction to its destruction to a stage of the profile
+	class scope {
+		double* into;
+		std::chrono::steady_clock::time_point start;
+	public:
+		scope(double* into) : into(into), start(std::chrono::steady_clock::now()) { }
+		scope(const scope&) = delete;
+		~scope() { (*into) += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+	};
+
+	void begin(unsigned long iteration) {
+		current = generation_profile();
+		current.iteration = iteration;
+		allocations = allocation_count.load(std::memory_order_relaxed);
+	}
+
+	scope stage(double generation_profile::* s) { return scope(&(current.*s)); }
+
+	void evaluated(unsigned long n) { current.evaluations += n; }
+
+	template<typename Logger, typename Iterator>
+	void end(Logger& logger, const Iterator& begin, const Iterator& end) {
+		current.allocations = allocation_count.load(std::memory_order_relaxed) - allocations;
+		double sum = 0.0, best = std::numeric_limits<double>::infinity();
+		unsigned long n = 0;
+		for (Iterator i = begin; i != end; ++i) {
+			double y = double(std::get<1>(*i));
+			if (std::isnan(y)) continue;
+			sum += y; ++n;
+			if (y < best) best = y;
+		}
+		if (n > 0) { current.best = best; current.mean = sum/double(n); }
+		logger.profile(current);
+	}
+};
+
+} // namespace opt
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace opt {
+
+/**
+ * Non-owning view over a contiguous sequence of T: a minimal std::span, which is not
+ * available in C++17. It can be built from a pointer and a size or from any container
+ * with contiguous storage (providing data() and size()).
+ **/
+template<typename T>
+class span {
+	T*          data_;
+	std::size_t size_;
+public:
+	using element_type = T;
+	using value_type   = std::remove_cv_t<T>;
+	using size_type    = std::size_t;
+	using iterator     = T*;
+
+	constexpr span() : data_(nullptr), size_(0) { }
+	constexpr span(T* data, std::size_t size) : data_(data), size_(size) { }
+
+	template<typename U>
+	requires std::is_convertible_v<U(*)[], T(*)[]>
+	constexpr span(const span<U>& that) : data_(that.data()), size_(that.size()) { }
+
+	template<typename C>
+	requires requires(C& c) { { c.data() } -> T*; c.size(); }
+	constexpr span(C& c) : data_(c.data()), size_(c.size()) { }
+
+	constexpr T*          data()  const { return data_; }
+	constexpr std::size_t size()  const { return size_; }
+	constexpr bool        empty() const { return size_ == 0; }
+	constexpr T* begin() const { return data_; }
+	constexpr T* end()   const { return data_ + size_; }
+	constexpr T& operator[](std::size_t i) const { return data_[i]; }
+
+	constexpr span subspan(std::size_t offset, std::size_t count) const { return span(data_ + offset, count); }
+};
+
+} // namespace opt
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "concepts.h"
+#include <chrono>
+#include <atomic>
+#include <tuple>
+#include <iterator>
+#include <type_traits>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace opt {
+
+/**
+ * Stopping criteria shared by all the methods, on top of their own ones (number of iterations, threshold,
+ * step size...). Each of them is disabled (zero) unless set:
+ * - time(seconds): wall clock budget of the minimization.
+ * - evaluations(n): budget of evaluations of the function to minimize.
+ * - stagnation(k, tolerance): k iterations in a row without improving the best value by more than tolerance.
+ * - diversity(d): the population of population based methods has collapsed, as the mean standard deviation of
+ *   its genes (or of its values, if the genes are not numbers or containers of numbers) is below d.
+ * They are checked once per iteration, so the budgets can be exceeded by up to one iteration.
+ *
+ * The criteria are set as in opt::stopping().time(60).stagnation(100).
+ **/
+class stopping {
+	double         seconds_;
+	unsigned long  evaluations_;
+	unsigned long  stagnation_;
+	double         tolerance_;
+	double         diversity_;
+
+public:
+	stopping(double seconds = 0.0, unsigned long evaluations = 0, unsigned long stagnation = 0,
+	         double tolerance = 0.0, double diversity = 0.0) :
+		seconds_(seconds), evaluations_(evaluations), stagnation_(stagnation), tolerance_(tolerance), diversity_(diversity) { }
+
+	stopping time(double seconds) const { stopping s = *this; s.seconds_ = seconds; return s; }
+	stopping evaluations(unsigned long n) const { stopping s = *this; s.evaluations_ = n; return s; }
+	stopping stagnation(unsigned long k, double tolerance = 0.0) const {
+		stopping s = *this; s.stagnation_ = k; s.tolerance_ = tolerance; return s;
+	}
+	stopping diversity(double d) const { stopping s = *this; s.diversity_ = d; return s; }
+	//Only the time and evaluation budgets (for the parts of a minimization that cannot judge its progress)
+	stopping budgets() const { return stopping(seconds_, evaluations_); }
+
+	class monitor;
+	monitor start() const;
+	//Monitor of one of several concurrent parts of a minimization (as the islands of GeneticIslands), whose
+	//evaluations are added to a counter shared by all of them, so that the evaluation budget applies to their sum
+	monitor start(std::atomic<unsigned long>& evaluations) const;
+};
+
+/**
+ * State of the criteria along one minimization. The methods report the evaluations they perform and, after
+ * each iteration, either their best value or their population (a range of (genes, value) tuples or pairs).
+ **/
+class stopping::monitor {
+	stopping criteria;
+	std::chrono::steady_clock::time_point start;
+	std::atomic<unsigned long>* shared_ = nullptr;
+	unsigned long evaluations_ = 0;
+	unsigned long stagnant_    = 0;
+	double        best_        = std::numeric_limits<double>::infinity();
+	bool          collapsed_   = false;
+
+	template<typename T>
+	struct statistics {
+		double sum = 0.0, squares = 0.0; unsigned long n = 0;
+		void add(T v) { if (std::isfinite(double(v))) { sum += double(v); squares += double(v)*double(v); ++n; } }
+		double stddev() const {
+			if (n < 2) return 0.0;
+			double mean = sum/double(n);
+			return std::sqrt(std::max(0.0, squares/double(n) - mean*mean));
+		}
+	};
+
+	//Standard deviation of the values of the function
+	template<typename Iterator>
+	static double values_diversity(const Iterator& begin, const Iterator& end) {
+		statistics<std::decay_t<decltype(std::get<1>(*begin))>> s;
+		for (Iterator i = begin; i != end; ++i) s.add(std::get<1>(*i));
+		return s.stddev();
+	}
+
+	//Mean standard deviation of the genes, or of the values if the genes are not numbers
+	template<typename Iterator>
+	static double diversity(const Iterator& begin, const Iterator& end) {
+		using XType = std::decay_t<decltype(std::get<0>(*begin))>;
+		if constexpr (std::is_arithmetic_v<XType>) {
+			statistics<XType> s;
+			for (Iterator i = begin; i != end; ++i) s.add(std::get<0>(*i));
+			return s.stddev();
+		} else if constexpr (RandomAccessContainer<XType>) {
+			if constexpr (std::is_arithmetic_v<typename XType::value_type>) {
+				if (begin == end) return 0.0;
+				std::size_t n = std::get<0>(*begin).size();
+				if (n == 0) return 0.0;
+				double total = 0.0;
+				for (std::size_t j = 0; j < n; ++j) {
+					statistics<double> s;
+					for (Iterator i = begin; i != end; ++i) if (std::get<0>(*i).size() > j) s.add(double(std::get<0>(*i)[j]));
+					total += s.stddev();
+				}
+				return total/double(n);
+			} else return values_diversity(begin, end);
+		} else return values_diversity(begin, end);
+	}
+
+public:
+	//What a checkpoint keeps of a monitor, so that a resumed minimization continues with its budgets and stagnation
+	//(all the fields have the same size, so there are no padding bytes when it is saved as raw bytes)
+	struct state {
+		unsigned long evaluations;
+		unsigned long stagnant;
+		double        best;
+		double        elapsed;	// seconds
+		unsigned long collapsed;	// 1 if the population has collapsed
+	};
+
+	monitor(const stopping& criteria, std::atomic<unsigned long>* shared = nullptr) :
+		criteria(criteria), start(std::chrono::steady_clock::now()), shared_(shared) { }
+
+	void evaluated(unsigned long n) { evaluations_ += n; if (shared_) (*shared_) += n; }
+
+	//End of the given number of iterations (more than one if they are only reported from time to time)
+	template<typename YType>
+	void iteration(const YType& best, unsigned long iterations = 1) {
+		if (double(best) < best_ - criteria.tolerance_) { best_ = double(best); stagnant_ = 0; }
+		else stagnant_ += iterations;
+	}
+
+	template<typename Iterator>
+	requires requires(Iterator i) { std::get<0>(*i); std::get<1>(*i); ++i; }
+	void iteration(const Iterator& begin, const Iterator& end, unsigned long iterations = 1) {
+		double best = std::numeric_limits<double>::infinity();
+		for (Iterator i = begin; i != end; ++i) if (double(std::get<1>(*i)) < best) best = double(std::get<1>(*i));
+		iteration(best, iterations);
+		if (criteria.diversity_ > 0.0) collapsed_ = (diversity(begin, end) < criteria.diversity_);
+	}
+
+	bool stop() const {
+		if ((criteria.evaluations_ > 0) && (evaluations() >= criteria.evaluations_)) return true;
+		if ((criteria.stagnation_ > 0) && (stagnant_ >= criteria.stagnation_)) return true;
+		if (collapsed_) return true;
+		if (criteria.seconds_ > 0.0) {
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			if (elapsed.count() >= criteria.seconds_) return true;
+		}
+		return false;
+	}
+
+	//Evaluations of the minimization (of all its parts, if they share the count)
+	unsigned long evaluations() const { return shared_?shared_->load():evaluations_; }
+	unsigned long stagnant() const { return stagnant_; }
+	double elapsed() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+
+	state saved() const { return state{evaluations_, stagnant_, best_, elapsed(), collapsed_?1ul:0ul}; }
+	//Continues from a saved state, as if the time since it was saved had not passed
+	void restore(const state& s) {
+		evaluations_ = s.evaluations; stagnant_ = s.stagnant; best_ = s.best; collapsed_ = (s.collapsed != 0);
+		start = std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(s.elapsed));
+	}
+};
+
+inline stopping::monitor stopping::start() const { return monitor(*this); }
+inline stopping::monitor stopping::start(std::atomic<unsigned long>& evaluations) const { return monitor(*this, &evaluations); }
+
+} // namespace opt
@@ -1,38 +1,357 @@
 #pragma once
 
 #include "concepts.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <utility>
 
-namespace testfunction {
 /**
- * Simple Rosenbrock function implementation
+ * Standard test functions for optimization, templated on the dimension N and the scalar type Real. All of them
+ * take any random access container of size N, and provide:
+ * - gradient(v): the analytic gradient, as the same container type as v.
+ * - optimum(): the position of the global minimum, and minimum(), its value.
+ * - lower() and upper(): the usual search domain (the same for each coordinate).
+ * - error(v): the euclidean distance from v to the optimum.
+ * The loops do not carry dependencies apart from the accumulation, so that they vectorize.
  *
- * Reference: https://en.wikipedia.org/wiki/Rosenbrock_function
+ * Reference: https://en.wikipedia.org/wiki/Test_functions_for_optimization
+ **/
+namespace testfunction {
+
+namespace detail {
+	template<typename Real>
+	constexpr Real pi = Real(3.141592653589793238462643383279502884L);
+
+	template<typename Real, std::size_t N, typename V>
+	Real distance(const std::array<Real,N>& optimum, const V& v) {
+		Real d(0);
+		for (std::size_t i = 0; i < N; ++i) d += (v[i] - optimum[i])*(v[i] - optimum[i]);
+		return std::sqrt(d);
+	}
+
+	template<typename Real, std::size_t N>
+	std::array<Real,N> filled(Real value) {
+		std::array<Real,N> a; a.fill(value); return a;
+	}
+}
+
+/**
+ * Rosenbrock function. For more than two dimensions this is the extended Rosenbrock function, the sum of
+ * the two dimensional one over the pairs of consecutive coordinates (x0,x1), (x2,x3)... so N must be even.
+ * rosenbrock is the two dimensional one in single precision.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class rosenbrock_n {
+	static_assert((N % 2) == 0, "The extended Rosenbrock function requires an even dimension");
+	Real a;
+	Real b;
+public:
+	static constexpr std::size_t dimension = N;
+
+	rosenbrock_n(Real a = 1, Real b = 100) : a(a), b(b) { }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real s(0);
+		for (std::size_t i = 0; i < N; i += 2) {
+			Real x = v[i]; Real y = v[i+1];
+			s += (a - x)*(a - x) + b*(y - x*x)*(y - x*x);
+		}
+		return s;
+	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	V g = v;
+		for (std::size_t i = 0; i < N; i += 2) {
+			Real x = v[i]; Real y = v[i+1];
+			g[i]   = Real(-2)*(a - x) - Real(4)*b*x*(y - x*x);
+			g[i+1] = Real(2)*b*(y - x*x);
+		}
+		return g;
+	}
+
+	std::array<Real,N> optimum() const {
+		std::array<Real,N> o;
+		for (std::size_t i = 0; i < N; i += 2) { o[i] = a; o[i+1] = a*a; }
+		return o;
+	}
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-5); }
+	Real upper() const { return Real(10); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+using rosenbrock = rosenbrock_n<2, float>;
+
+/**
+ * Sphere function: the sum of squares.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class sphere {
+public:
+	static constexpr std::size_t dimension = N;
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real s(0);
+		for (std::size_t i = 0; i < N; ++i) s += Real(v[i])*Real(v[i]);
+		return s;
+	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	V g = v;
+		for (std::size_t i = 0; i < N; ++i) g[i] = Real(2)*v[i];
+		return g;
+	}
+
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(0)); }
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-5.12); }
+	Real upper() const { return Real(5.12); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Rastrigin function: a sphere modulated by a cosine, with a regular grid of local minima.
  **/
-class rosenbrock {
-	float a;
-	float b;
+template<std::size_t N = 2, typename Real = float>
+class rastrigin {
 public:
-	rosenbrock(float a = 1, float b = 100) : a(a), b(b) { }
+	static constexpr std::size_t dimension = N;
 
 	template<typename V>
 	requires RandomAccessContainer<V>
-	float operator()(const V& v) const
-	{	auto x = v[0];	auto y = v[1];
-		return (a - x)*(a - x) + b*(y - x*x)*(y - x*x); 
+	Real operator()(const V& v) const
+	{	Real s = Real(10)*Real(N);
+		for (std::size_t i = 0; i < N; ++i) s += Real(v[i])*Real(v[i]) - Real(10)*std::cos(Real(2)*detail::pi<Real>*Real(v[i]));
+		return s;
 	}
 
 	template<typename V>
 	requires RandomAccessContainer<V>
 	V gradient(const V& v) const
-	{	auto x = v[0];	auto y = v[1];
-		return V{{-2.0f*(a - x) - 2.0f*b*x*(y - x*x), 2.0f*b*(y - x*x)}};	
+	{	V g = v;
+		for (std::size_t i = 0; i < N; ++i) g[i] = Real(2)*v[i] + Real(20)*detail::pi<Real>*std::sin(Real(2)*detail::pi<Real>*Real(v[i]));
+		return g;
 	}
 
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(0)); }
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-5.12); }
+	Real upper() const { return Real(5.12); }
+
 	template<typename V>
 	requires RandomAccessContainer<V>
-	float error(const V& v) const {
-		return std::sqrt((v[0] - a)*(v[0] - a) + (v[1] - a*a)*(v[1] - a*a));
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Ackley function: nearly flat outer region with many local minima and a deep hole at the origin.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class ackley {
+public:
+	static constexpr std::size_t dimension = N;
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real squares(0), cosines(0);
+		for (std::size_t i = 0; i < N; ++i) {
+			squares += Real(v[i])*Real(v[i]);
+			cosines += std::cos(Real(2)*detail::pi<Real>*Real(v[i]));
+		}
+		return Real(-20)*std::exp(Real(-0.2)*std::sqrt(squares/Real(N))) - std::exp(cosines/Real(N)) + Real(20) + std::exp(Real(1));
 	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	Real squares(0), cosines(0);
+		for (std::size_t i = 0; i < N; ++i) {
+			squares += Real(v[i])*Real(v[i]);
+			cosines += std::cos(Real(2)*detail::pi<Real>*Real(v[i]));
+		}
+		Real r = std::sqrt(squares/Real(N));
+		Real radial = (r > Real(0))?(Real(4)*std::exp(Real(-0.2)*r)/(Real(N)*r)):Real(0);
+		Real periodic = Real(2)*detail::pi<Real>*std::exp(cosines/Real(N))/Real(N);
+		V g = v;
+		for (std::size_t i = 0; i < N; ++i) g[i] = radial*v[i] + periodic*std::sin(Real(2)*detail::pi<Real>*Real(v[i]));
+		return g;
+	}
+
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(0)); }
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-32.768); }
+	Real upper() const { return Real(32.768); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Griewank function: a wide sphere with a product of cosines that couples all the coordinates.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class griewank {
+public:
+	static constexpr std::size_t dimension = N;
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real s(0), p(1);
+		for (std::size_t i = 0; i < N; ++i) {
+			s += Real(v[i])*Real(v[i]);
+			p *= std::cos(Real(v[i])/std::sqrt(Real(i + 1)));
+		}
+		return Real(1) + s/Real(4000) - p;
+	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	//Product of all the cosines but the i-th one, from the prefix and suffix products (no divisions)
+		std::array<Real,N+1> prefix, suffix;
+		prefix[0] = Real(1); suffix[N] = Real(1);
+		for (std::size_t i = 0; i < N; ++i) prefix[i+1] = prefix[i]*std::cos(Real(v[i])/std::sqrt(Real(i + 1)));
+		for (std::size_t i = N; i > 0; --i) suffix[i-1] = suffix[i]*std::cos(Real(v[i-1])/std::sqrt(Real(i)));
+		V g = v;
+		for (std::size_t i = 0; i < N; ++i) {
+			Real root = std::sqrt(Real(i + 1));
+			g[i] = Real(v[i])/Real(2000) + prefix[i]*suffix[i+1]*std::sin(Real(v[i])/root)/root;
+		}
+		return g;
+	}
+
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(0)); }
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-600); }
+	Real upper() const { return Real(600); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Schwefel function: its global minimum is far from the next best local minima, close to the bounds.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class schwefel {
+public:
+	static constexpr std::size_t dimension = N;
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real s = Real(418.9828872724338)*Real(N);
+		for (std::size_t i = 0; i < N; ++i) s -= Real(v[i])*std::sin(std::sqrt(std::abs(Real(v[i]))));
+		return s;
+	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	V g = v;
+		for (std::size_t i = 0; i < N; ++i) {
+			Real root = std::sqrt(std::abs(Real(v[i])));
+			g[i] = -std::sin(root) - Real(0.5)*root*std::cos(root);
+		}
+		return g;
+	}
+
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(420.9687463)); }
+	Real minimum() const { return Real(0); }
+	Real lower() const { return Real(-500); }
+	Real upper() const { return Real(500); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Styblinski-Tang function: a separable quartic with its minimum at a corner of the (-5,5)^N box.
+ **/
+template<std::size_t N = 2, typename Real = float>
+class styblinski_tang {
+public:
+	static constexpr std::size_t dimension = N;
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real operator()(const V& v) const
+	{	Real s(0);
+		for (std::size_t i = 0; i < N; ++i) {
+			Real x2 = Real(v[i])*Real(v[i]);
+			s += x2*x2 - Real(16)*x2 + Real(5)*Real(v[i]);
+		}
+		return Real(0.5)*s;
+	}
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	V gradient(const V& v) const
+	{	V g = v;
+		for (std::size_t i = 0; i < N; ++i) g[i] = Real(2)*v[i]*v[i]*v[i] - Real(16)*v[i] + Real(2.5);
+		return g;
+	}
+
+	std::array<Real,N> optimum() const { return detail::filled<Real,N>(Real(-2.903534027771178)); }
+	Real minimum() const { return Real(-39.16616570377142)*Real(N); }
+	Real lower() const { return Real(-5); }
+	Real upper() const { return Real(5); }
+
+	template<typename V>
+	requires RandomAccessContainer<V>
+	Real error(const V& v) const { return detail::distance(optimum(), v); }
+};
+
+/**
+ * Wraps a function and counts its evaluations (and those of its gradient, if it has one). The counters are
+ * shared by the copies of the wrapper and are atomic, so the methods can copy it and call it from several
+ * threads. The function is called on any argument, so it also counts the evaluations on AD scalars. Batch
+ * calls (see opt::BatchTargetFunction) count as many evaluations as elements they evaluate.
+ **/
+template<typename F>
+class counted {
+	F f;
+	std::shared_ptr<std::atomic<unsigned long>> values;
+	std::shared_ptr<std::atomic<unsigned long>> gradients;
+public:
+	counted(const F& f) : f(f),
+		values(std::make_shared<std::atomic<unsigned long>>(0)),
+		gradients(std::make_shared<std::atomic<unsigned long>>(0)) { }
+
+	template<typename V>
+	auto operator()(const V& v) const -> decltype(std::declval<const F&>()(v)) { ++(*values); return f(v); }
+
+	template<typename X, typename Y>
+	auto operator()(const X& x, const Y& y) const -> decltype(std::declval<const F&>()(x, y)) { (*values) += x.size(); return f(x, y); }
+
+	template<typename V, typename G = F>
+	auto gradient(const V& v) const -> decltype(std::declval<const G&>().gradient(v)) { ++(*gradients); return f.gradient(v); }
+
+	unsigned long evaluations() const { return *values; }
+	unsigned long gradient_evaluations() const { return *gradients; }
+	void reset() { (*values) = 0; (*gradients) = 0; }
 };
 
-} //namespace testfunction
\ No newline at end of file
+} //namespace testfunction
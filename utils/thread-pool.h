@@ -0,0 +1,117 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+namespace opt {
+
+/**
+ * Fixed-size pool of worker threads that only supports a blocking parallel loop, which is
+ * all the optimization methods need. The calling thread also takes its share of the work, so
+ * a pool of n threads spawns n-1 workers (and a pool of 1 thread just runs the loop inline).
+ *
+ * Iterations are handed out dynamically, one at a time, so it copes well with objective
+ * functions whose evaluation time varies. Nested calls to parallel_for on the same pool are
+ * not supported.
+ **/
+class thread_pool {
+	std::vector<std::thread>          workers;
+	std::mutex                        mutex;
+	std::condition_variable           wake, done;
+	std::function<void(std::size_t)>  task;
+	std::size_t                       ntasks = 0;
+	std::atomic<std::size_t>          next{0};
+	unsigned int                      active = 0;
+	unsigned long                     generation = 0;
+	bool                              stopping = false;
+	std::exception_ptr                error;
+
+	void run() {
+		for (std::size_t i = next++; i < ntasks; i = next++) {
+			try { task(i); }
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error) error = std::current_exception();
+			}
+		}
+	}
+
+	void work() {
+		unsigned long seen = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [this, seen] { return stopping || (generation != seen); });
+				if (stopping) return;
+				seen = generation;
+			}
+			run();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if ((--active) == 0) done.notify_one();
+			}
+		}
+	}
+
+public:
+	/**
+	 * Number of threads of a pool created with nthreads (0 uses as many threads as the hardware supports).
+	 **/
+	static unsigned int threads(unsigned int nthreads) {
+		return (nthreads == 0)?std::max(1u, std::thread::hardware_concurrency()):nthreads;
+	}
+
+	/**
+	 * nthreads = 0 uses as many threads as the hardware supports.
+	 **/
+	thread_pool(unsigned int nthreads = 0) {
+		nthreads = threads(nthreads);
+		for (unsigned int t = 1; t < nthreads; ++t) workers.emplace_back([this] { this->work(); });
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& w : workers) w.join();
+	}
+
+	unsigned int size() const { return workers.size() + 1; }
+
+	/**
+	 * Calls f(i) for every i in [0,n), distributed among the threads of the pool, and waits until
+	 * all of them have finished. If any call throws, the first exception is rethrown here.
+	 **/
+	template<typename F>
+	void parallel_for(std::size_t n, const F& f) {
+		if (workers.empty() || (n <= 1)) {
+			for (std::size_t i = 0; i < n; ++i) f(i);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			task = [&f] (std::size_t i) { f(i); };
+			ntasks = n; next = 0; error = nullptr;
+			active = workers.size();
+			++generation;
+		}
+		wake.notify_all();
+		run();
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this] { return active == 0; });
+		if (error) std::rethrow_exception(error);
+	}
+};
+
+} // namespace opt
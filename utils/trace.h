@@ -0,0 +1,174 @@
+#pragma once
+
+#include "mapped-file.h"
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <stdexcept>
+
+namespace opt {
+
+/**
+ * Binary trace of the populations of an optimization: a header followed by one record per iteration with
+ * - the iteration (uint64) and the number of individuals n (uint64),
+ * - the n values of the function (float or double, as YType),
+ * - optionally, the n genomes as raw bytes (only for trivially copyable XType, such as std::array<float,N>),
+ * padded to 8 bytes. The header keeps the number of bytes of complete records, so a trace whose program was
+ * killed can still be read up to its last iteration. All numbers are in the byte order of the machine.
+ **/
+struct trace_header {
+	char          magic[8]     = {'O','P','T','T','R','A','C','E'};
+	std::uint32_t version      = 1;
+	std::uint32_t fitness_size = 0;	// sizeof(YType): 4 or 8
+	std::uint32_t genome_size  = 0;	// sizeof(XType), 0 if the genomes are not stored
+	std::uint32_t reserved     = 0;
+	std::uint64_t bytes        = 0;	// bytes of the trace (header and complete records)
+};
+
+/**
+ * Appends the populations to a trace file, mapped in memory (see mapped-file.h), so that each record costs
+ * little more than copying the values. The layout is fixed by the first population written.
+ **/
+class trace_writer {
+	mapped_file_writer file;
+	bool               genomes;
+	bool               started = false;
+
+	static std::size_t padded(std::size_t n) { return (n + 7) & ~std::size_t(7); }
+
+public:
+	trace_writer(const std::string& path, bool genomes = true) : file(path), genomes(genomes) { }
+
+	//Range of (XType, YType) tuples or pairs
+	template<typename Iterator>
+	void write(unsigned long iteration, const Iterator& begin, const Iterator& end) {
+		using XType = std::decay_t<decltype(std::get<0>(*begin))>;
+		using YType = std::decay_t<decltype(std::get<1>(*begin))>;
+		static_assert(std::is_floating_point_v<YType>, "Traces store floating point values");
+		constexpr std::size_t genome_size = std::is_trivially_copyable_v<XType>?sizeof(XType):0;
+		if (!started) {
+			trace_header header;
+			header.fitness_size = sizeof(YType);
+			header.genome_size  = genomes?std::uint32_t(genome_size):0;
+			header.bytes        = sizeof(trace_header);
+			std::memcpy(file.extend(sizeof(trace_header)), &header, sizeof(trace_header));
+			started = true;
+		}
+		const bool with_genomes = genomes && (genome_size > 0);
+		const std::uint64_t n = std::uint64_t(std::distance(begin, end));
+		char* record = file.extend(padded(2*sizeof(std::uint64_t) + n*(sizeof(YType) + (with_genomes?genome_size:0))));
+		const std::uint64_t it = iteration;
+		std::memcpy(record, &it, sizeof(std::uint64_t)); record += sizeof(std::uint64_t);
+		std::memcpy(record, &n, sizeof(std::uint64_t));  record += sizeof(std::uint64_t);
+		for (Iterator i = begin; i != end; ++i, record += sizeof(YType)) {
+			YType y = std::get<1>(*i);
+			std::memcpy(record, &y, sizeof(YType));
+		}
+		if constexpr (genome_size > 0) if (with_genomes)
+			for (Iterator i = begin; i != end; ++i, record += genome_size) std::memcpy(record, &std::get<0>(*i), genome_size);
+		std::uint64_t bytes = file.size();
+		std::memcpy(file.data() + offsetof(trace_header, bytes), &bytes, sizeof(std::uint64_t));
+	}
+};
+
+/**
+ * Reads a trace written by trace_writer, as a range of records:
+ *
+ *    opt::trace_reader trace("run.trace");
+ *    for (const auto& record : trace) std::cout<<record.iteration()<<" "<<record.fitness(0)<<std::endl;
+ *
+ * Throws std::runtime_error if the file is not a trace.
+ **/
+class trace_reader {
+	mapped_file_reader file;
+	trace_header       header;
+
+public:
+	class record {
+		const trace_header* header;
+		const char*         data;
+	public:
+		record(const trace_header* header, const char* data) : header(header), data(data) { }
+
+		unsigned long iteration() const { std::uint64_t v; std::memcpy(&v, data, sizeof(v)); return v; }
+		std::size_t size() const { std::uint64_t v; std::memcpy(&v, data + sizeof(v), sizeof(v)); return v; }
+
+		double fitness(std::size_t i) const {
+			const char* p = data + 2*sizeof(std::uint64_t) + i*header->fitness_size;
+			if (header->fitness_size == sizeof(float)) { float y; std::memcpy(&y, p, sizeof(y)); return y; }
+			else { double y; std::memcpy(&y, p, sizeof(y)); return y; }
+		}
+
+		bool has_genomes() const { return header->genome_size > 0; }
+		//Raw bytes of the genome of the i-th individual
+		const void* genome_data(std::size_t i) const {
+			return data + 2*sizeof(std::uint64_t) + size()*header->fitness_size + i*header->genome_size;
+		}
+		//Genome of the i-th individual, which must have been written as a XType
+		template<typename XType>
+		XType genome(std::size_t i) const {
+			static_assert(std::is_trivially_copyable_v<XType>, "Only trivially copyable genomes are traced");
+			XType x; std::memcpy(&x, genome_data(i), sizeof(XType)); return x;
+		}
+
+		std::size_t bytes() const {
+			return (2*sizeof(std::uint64_t) + size()*(header->fitness_size + header->genome_size) + 7) & ~std::size_t(7);
+		}
+	};
+
+	//Records that do not fit before end (as the last one of a file that was cut) end the range
+	class iterator {
+		const trace_header* header;
+		const char*         data;
+		const char*         end;
+
+		bool complete() const {
+			std::size_t left = std::size_t(end - data);
+			if (left < 2*sizeof(std::uint64_t)) return false;
+			record r(header, data);
+			return (r.size() <= (left - 2*sizeof(std::uint64_t))/(header->fitness_size + header->genome_size)) && (r.bytes() <= left);
+		}
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = record;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const record*;
+		using reference         = record;
+
+		iterator(const trace_header* header, const char* data, const char* end) : header(header), data(data), end(end) {
+			if ((data != end) && !complete()) this->data = end;
+		}
+		record operator*() const { return record(header, data); }
+		iterator& operator++() { 
+			data += record(header, data).bytes(); 
+			if (!complete()) data = end;
+			return *this; 
+		}
+		bool operator==(const iterator& that) const { return data == that.data; }
+		bool operator!=(const iterator& that) const { return data != that.data; }
+	};
+
+	trace_reader(const std::string& path) : file(path) {
+		if ((file.size() < sizeof(trace_header)) || (std::memcmp(file.data(), header.magic, sizeof(header.magic)) != 0))
+			throw std::runtime_error(path + " is not an optimization trace");
+		std::memcpy(&header, file.data(), sizeof(trace_header));
+		if ((header.fitness_size != sizeof(float)) && (header.fitness_size != sizeof(double)))
+			throw std::runtime_error(path + " has an unsupported value type");
+		if (header.bytes < sizeof(trace_header))
+			throw std::runtime_error(path + " has a corrupt header");
+		header.bytes = std::min<std::uint64_t>(header.bytes, file.size());
+	}
+
+	std::size_t fitness_size() const { return header.fitness_size; }
+	std::size_t genome_size() const { return header.genome_size; }
+
+	iterator begin() const { return iterator(&header, file.data() + sizeof(trace_header), file.data() + header.bytes); }
+	iterator end() const { return iterator(&header, file.data() + header.bytes, file.data() + header.bytes); }
+};
+
+} // namespace opt